@@ -0,0 +1,241 @@
+// Minimal self-contained benchmark harness for ct_string_bench.
+//
+// Each benchmark body runs `iterations` times per sample; the iteration count is calibrated so a
+// sample takes about --min-time-ms, and the reported figures are medians over --samples samples.
+// On Linux, cycles and instructions per operation are read with perf_event_open when the kernel
+// allows it (see /proc/sys/kernel/perf_event_paranoid); elsewhere they are reported as null.
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+// Keeps `value` alive and opaque to the optimizer
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// Hides where a value came from, so it cannot be constant-folded into the benchmark body
+template<typename T>
+inline T launder(T value) {
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (std::is_scalar_v<T>) {
+        asm volatile("" : "+r"(value) : : "memory");
+    } else {
+        asm volatile("" : "+m"(value) : : "memory");
+    }
+#endif
+    return value;
+}
+
+#if defined(__linux__)
+class perf_counter {
+public:
+    explicit perf_counter(std::uint64_t config) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+    perf_counter(const perf_counter&) = delete;
+    perf_counter& operator=(const perf_counter&) = delete;
+    ~perf_counter() {
+        if (fd_ >= 0) close(fd_);
+    }
+
+    bool available() const { return fd_ >= 0; }
+    void start() {
+        if (fd_ < 0) return;
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    std::uint64_t stop() {
+        if (fd_ < 0) return 0;
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        std::uint64_t count = 0;
+        if (read(fd_, &count, sizeof(count)) != sizeof(count)) return 0;
+        return count;
+    }
+
+private:
+    int fd_ = -1;
+};
+#else
+class perf_counter {
+public:
+    explicit perf_counter(std::uint64_t) {}
+    bool available() const { return false; }
+    void start() {}
+    std::uint64_t stop() { return 0; }
+};
+#endif
+
+struct result {
+    std::string name;
+    std::uint64_t iterations = 0;
+    double ns_per_op = 0;
+    std::optional<double> cycles_per_op;
+    std::optional<double> instructions_per_op;
+};
+
+struct options {
+    std::string filter;
+    std::string json_path; // "-" writes JSON to stdout instead of the table
+    double min_time_ms = 20;
+    int samples = 7;
+};
+
+class runner {
+public:
+    explicit runner(options opts) : opts_(std::move(opts)) {}
+
+    // Registers and immediately runs `body(iterations)` unless filtered out
+    template<typename Body>
+    void run(const std::string& name, Body body) {
+        if (!opts_.filter.empty() && name.find(opts_.filter) == std::string::npos) return;
+
+        std::uint64_t iterations = 1;
+        for (;;) {
+            const double ns = time_ns(body, iterations);
+            if (ns >= opts_.min_time_ms * 1e6 || iterations >= (std::uint64_t{1} << 40)) break;
+            iterations = ns < 1000 ? iterations * 16 : static_cast<std::uint64_t>(iterations * opts_.min_time_ms * 1.2e6 / ns) + 1;
+        }
+
+        std::vector<double> ns_samples, cycle_samples, instruction_samples;
+        for (int s = 0; s < opts_.samples; ++s) {
+            cycles_.start();
+            instructions_.start();
+            ns_samples.push_back(time_ns(body, iterations) / iterations);
+            instruction_samples.push_back(static_cast<double>(instructions_.stop()) / iterations);
+            cycle_samples.push_back(static_cast<double>(cycles_.stop()) / iterations);
+        }
+
+        result r;
+        r.name = name;
+        r.iterations = iterations;
+        r.ns_per_op = median(ns_samples);
+        if (cycles_.available()) r.cycles_per_op = median(cycle_samples);
+        if (instructions_.available()) r.instructions_per_op = median(instruction_samples);
+        if (opts_.json_path != "-") print_row(r);
+        results_.push_back(std::move(r));
+    }
+
+    // Writes the JSON report if one was requested; returns false on I/O failure
+    bool finish() const {
+        if (opts_.json_path.empty()) return true;
+        std::FILE* out = opts_.json_path == "-" ? stdout : std::fopen(opts_.json_path.c_str(), "w");
+        if (!out) return false;
+        std::fprintf(out, "{\n  \"benchmarks\": [\n");
+        for (std::size_t i = 0; i < results_.size(); ++i) {
+            const result& r = results_[i];
+            std::fprintf(out, "    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.4f, \"cycles_per_op\": %s, "
+                              "\"instructions_per_op\": %s}%s\n",
+                         r.name.c_str(), static_cast<unsigned long long>(r.iterations), r.ns_per_op,
+                         optional_number(r.cycles_per_op).c_str(), optional_number(r.instructions_per_op).c_str(),
+                         i + 1 < results_.size() ? "," : "");
+        }
+        std::fprintf(out, "  ]\n}\n");
+        return out == stdout || std::fclose(out) == 0;
+    }
+
+    void print_header() const {
+        if (opts_.json_path == "-") return;
+        std::printf("%-48s %12s %10s %10s\n", "benchmark", "ns/op", "cycles/op", "instr/op");
+        if (!cycles_.available()) std::printf("(hardware counters unavailable; cycles and instructions not reported)\n");
+    }
+
+private:
+    template<typename Body>
+    static double time_ns(Body& body, std::uint64_t iterations) {
+        const auto start = std::chrono::steady_clock::now();
+        body(iterations);
+        const auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count();
+    }
+
+    static double median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    static std::string optional_number(const std::optional<double>& value) {
+        if (!value) return "null";
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.2f", *value);
+        return buffer;
+    }
+
+    static void print_row(const result& r) {
+        std::printf("%-48s %12.3f", r.name.c_str(), r.ns_per_op);
+        if (r.cycles_per_op) std::printf(" %10.1f", *r.cycles_per_op); else std::printf(" %10s", "-");
+        if (r.instructions_per_op) std::printf(" %10.1f", *r.instructions_per_op); else std::printf(" %10s", "-");
+        std::printf("\n");
+    }
+
+    options opts_;
+#if defined(__linux__)
+    perf_counter cycles_{PERF_COUNT_HW_CPU_CYCLES};
+    perf_counter instructions_{PERF_COUNT_HW_INSTRUCTIONS};
+#else
+    perf_counter cycles_{0};
+    perf_counter instructions_{0};
+#endif
+    std::vector<result> results_;
+};
+
+// Parses --filter=<substring>, --json[=<path>], --min-time-ms=<n> and --samples=<n>
+inline std::optional<options> parse_options(int argc, char** argv) {
+    options opts;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const auto value_of = [&](std::string_view flag) -> std::optional<std::string> {
+            if (arg.substr(0, flag.size()) != flag) return std::nullopt;
+            return std::string(arg.substr(flag.size()));
+        };
+        if (arg == "--json") {
+            opts.json_path = "-";
+        } else if (auto v = value_of("--json=")) {
+            opts.json_path = *v;
+        } else if (auto v = value_of("--filter=")) {
+            opts.filter = *v;
+        } else if (auto v = value_of("--min-time-ms=")) {
+            opts.min_time_ms = std::atof(v->c_str());
+        } else if (auto v = value_of("--samples=")) {
+            opts.samples = std::max(1, std::atoi(v->c_str()));
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter=<substring>] [--json[=<path>]] [--min-time-ms=<n>] [--samples=<n>]\n", argv[0]);
+            return std::nullopt;
+        }
+    }
+    return opts;
+}
+
+} // namespace bench
@@ -0,0 +1,56 @@
+// Representative ct_string usage for the bloat report (tools/bloat_report.py): the patterns an
+// application repeats across many files, each creating ct_string<N> types of distinct lengths.
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#ifdef CT_STRING_HEADER_ONLY
+#include <ct_string/ct_string.hpp>
+#else
+import ct_string;
+#endif
+
+namespace {
+
+// Paths composed with operator+ in constant expressions
+constexpr ct_string asset_root = "assets/";
+constexpr auto texture_dir = asset_root + ct_string("textures/");
+constexpr auto shader_dir = asset_root + ct_string("shaders/");
+constexpr auto stone = texture_dir + ct_string("stone.png");
+constexpr auto water = shader_dir + ct_string("water.glsl");
+
+// Functions parameterized on a string, one instantiation per distinct value
+template<ct_string Name>
+std::size_t count_occurrences(std::string_view text) {
+    std::size_t count = 0;
+    for (std::size_t pos = text.find(std::string_view(Name)); pos != std::string_view::npos;
+         pos = text.find(std::string_view(Name), pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+// Runtime comparisons against constants
+bool is_stone(std::string_view path) { return path == stone; }
+bool is_water(std::string_view path) { return path == water; }
+bool before_water(std::string_view path) { return (path <=> water) < 0; }
+
+// Conversions
+std::string stone_copy() { return std::string(stone); }
+const char* water_c_str() { return water.c_str(); }
+
+// Case-insensitive header matching and keyword lookup
+bool is_content_type(std::string_view header) { return iequals<"Content-Type">(header); }
+bool is_content_length(std::string_view header) { return iequals<"Content-Length">(header); }
+std::size_t method_index(std::string_view method) {
+    return ci_perfect_hash<"GET", "HEAD", "POST", "PUT", "DELETE", "OPTIONS">::find(method);
+}
+
+std::size_t count_errors(std::string_view log) { return count_occurrences<"error">(log); }
+std::size_t count_warnings(std::string_view log) { return count_occurrences<"warning">(log); }
+
+// Digests folded at compile time
+std::uint32_t stone_id() { return crc32c_v<stone>; }
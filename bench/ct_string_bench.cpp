@@ -0,0 +1,360 @@
+// Runtime microbenchmarks for the operations ct_string replaces std::string_view / std::string for.
+//
+//   ct_string_bench [--filter=<substring>] [--json[=<path>]] [--min-time-ms=<n>] [--samples=<n>]
+//
+// Every comparison runs against an equal string of the same length (the worst case: all
+// characters are inspected) and the runtime operand is hidden from the optimizer.
+#include "bench_harness.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>      // For mkostemp
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#if __has_include(<fcntl.h>)
+#include <fcntl.h>      // For opening /dev/null
+#include <unistd.h>
+#endif
+
+#ifdef CT_STRING_HEADER_ONLY
+#include <ct_string/ct_string.hpp>
+#include <ct_string/ct_string.log.hpp>
+#include <ct_string/ct_string.metrics.hpp>
+#include <ct_string/ct_string.http.hpp>
+#include <ct_string/ct_string.uring.hpp>
+#else
+import ct_string;
+import ct_string.log;
+import ct_string.metrics;
+import ct_string.http;
+import ct_string.uring;
+#endif
+
+namespace {
+
+// "abcd...zabcd..." of length N
+template<std::size_t N>
+constexpr ct_string<N> filled() {
+    ct_string<N> s{};
+    for (std::size_t i = 0; i < N; ++i) {
+        s.data[i] = static_cast<char>('a' + i % 26);
+    }
+    return s;
+}
+
+// Stream buffer that discards its output, so stream benchmarks measure the formatting path only
+class null_buffer : public std::streambuf {
+protected:
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+};
+
+template<std::size_t N>
+void bench_comparisons(bench::runner& runner) {
+    static constexpr auto literal = filled<N>();
+    static constexpr std::string_view literal_view = literal;
+    const std::string owned(literal_view);
+    const std::string other(literal_view);
+    const std::string_view input = other;
+    const std::string suffix = "/" + std::to_string(N);
+
+    runner.run("equal/ct_string==string_view" + suffix, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) bench::do_not_optimize(literal == bench::launder(input));
+    });
+    runner.run("equal/string_view==string_view" + suffix, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) bench::do_not_optimize(literal_view == bench::launder(input));
+    });
+    runner.run("equal/string==string" + suffix, [&](std::uint64_t n) {
+        const std::string* rhs = &other;
+        for (std::uint64_t i = 0; i < n; ++i) bench::do_not_optimize(owned == *bench::launder(rhs));
+    });
+    runner.run("compare/ct_string<=>string_view" + suffix, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) bench::do_not_optimize(literal <=> bench::launder(input));
+    });
+    runner.run("compare/string_view<=>string_view" + suffix, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) bench::do_not_optimize(literal_view <=> bench::launder(input));
+    });
+    runner.run("compare/string<=>string" + suffix, [&](std::uint64_t n) {
+        const std::string* rhs = &other;
+        for (std::uint64_t i = 0; i < n; ++i) bench::do_not_optimize(owned <=> *bench::launder(rhs));
+    });
+}
+
+template<std::size_t N>
+void bench_conversions(bench::runner& runner) {
+    static constexpr auto literal = filled<N>();
+    const auto* source = &literal;
+    const std::string suffix = "/" + std::to_string(N);
+
+    runner.run("convert/string_view" + suffix, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) bench::do_not_optimize(std::string_view(*bench::launder(source)));
+    });
+    runner.run("convert/const_char_ptr" + suffix, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) bench::do_not_optimize(static_cast<const char*>(*bench::launder(source)));
+    });
+    runner.run("convert/std_string" + suffix, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            std::string s(*bench::launder(source));
+            bench::do_not_optimize(s);
+        }
+    });
+}
+
+template<std::size_t N>
+void bench_output(bench::runner& runner) {
+    static constexpr auto literal = filled<N>();
+    static constexpr std::string_view literal_view = literal;
+    const std::string owned(literal_view);
+    const char* c_str = literal.c_str();
+    null_buffer buffer;
+    std::ostream os(&buffer);
+    const std::string suffix = "/" + std::to_string(N);
+
+    runner.run("ostream/ct_string" + suffix, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) os << literal;
+    });
+    runner.run("ostream/const_char_ptr" + suffix, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) os << bench::launder(c_str);
+    });
+    runner.run("ostream/std_string" + suffix, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) os << owned;
+    });
+}
+
+template<std::size_t N>
+void bench_hashing(bench::runner& runner) {
+    static constexpr auto literal = filled<N>();
+    static constexpr std::string_view literal_view = literal;
+    const std::string owned(literal_view);
+    const std::string_view input = owned;
+    const std::string suffix = "/" + std::to_string(N);
+
+    // A constant's hash is folded during compilation; the rest hash at runtime
+    runner.run("hash/crc32c_v<constant>" + suffix, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) bench::do_not_optimize(crc32c_v<literal>);
+    });
+    runner.run("hash/crc32c(string_view)" + suffix, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) bench::do_not_optimize(crc32c(bench::launder(input)));
+    });
+    runner.run("hash/std::hash<ct_string>" + suffix, [&](std::uint64_t n) {
+        const auto* s = &literal;
+        for (std::uint64_t i = 0; i < n; ++i) bench::do_not_optimize(std::hash<ct_string<N>>{}(*bench::launder(s)));
+    });
+    runner.run("hash/std::hash<string_view>" + suffix, [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) bench::do_not_optimize(std::hash<std::string_view>{}(bench::launder(input)));
+    });
+    runner.run("hash/std::hash<string>" + suffix, [&](std::uint64_t n) {
+        const std::string* s = &owned;
+        for (std::uint64_t i = 0; i < n; ++i) bench::do_not_optimize(std::hash<std::string>{}(*bench::launder(s)));
+    });
+}
+
+// Deferred logging against formatting on the hot path. The ct_log run drains its ring every
+// 256 records without formatting, as the background thread would, so it never drops.
+void bench_logging(bench::runner& runner) {
+    const std::string_view peer = "10.0.0.1";
+    int fd = 7;
+    runner.run("log/ct_log", [&](std::uint64_t n) {
+        auto& backend = log_backend::instance();
+        for (std::uint64_t i = 0; i < n; ++i) {
+            bench::do_not_optimize(ct_log<"accepted fd {} from {}:{} after {} ms", __FILE__, __LINE__>(
+                *bench::launder(&fd), bench::launder(peer), std::uint16_t{8080}, 0.25));
+            if ((i & 255) == 255) {
+                backend.drain([](const log_site&, std::span<const std::byte>) {});
+            }
+        }
+        backend.drain([](const log_site&, std::span<const std::byte>) {});
+    });
+    runner.run("log/snprintf", [&](std::uint64_t n) {
+        char line[128];
+        for (std::uint64_t i = 0; i < n; ++i) {
+            const std::string_view p = bench::launder(peer);
+            bench::do_not_optimize(std::snprintf(line, sizeof(line), "accepted fd %d from %.*s:%u after %g ms",
+                                                 *bench::launder(&fd), static_cast<int>(p.size()), p.data(), 8080u, 0.25));
+        }
+    });
+}
+
+// The registry metric_registry replaces: a name lookup under a mutex on every increment
+class mutex_map_registry {
+public:
+    void increment(const std::string& name) {
+        std::lock_guard lock(mutex_);
+        ++counters_[name];
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::uint64_t> counters_;
+};
+
+// Runs body(n / threads) on `threads` threads at once
+template<typename Body>
+void on_threads(unsigned threads, std::uint64_t n, const Body& body) {
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&] { body(n / threads); });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void bench_metrics(bench::runner& runner) {
+    using metrics = metric_registry<metric_counter<"requests_total">, metric_counter<"errors_total">>;
+    mutex_map_registry map_registry;
+    const std::string name = "requests_total";
+    for (const unsigned threads : {1u, 4u}) {
+        const std::string suffix = threads == 1 ? "" : "/" + std::to_string(threads) + "_threads";
+        runner.run("metrics/metric_registry" + suffix, [&](std::uint64_t n) {
+            on_threads(threads, n, [](std::uint64_t count) {
+                for (std::uint64_t i = 0; i < count; ++i) {
+                    metrics::increment<"requests_total">();
+                }
+            });
+            bench::do_not_optimize(metrics::scrape().get<"requests_total">());
+        });
+        runner.run("metrics/mutex_map" + suffix, [&](std::uint64_t n) {
+            on_threads(threads, n, [&](std::uint64_t count) {
+                for (std::uint64_t i = 0; i < count; ++i) {
+                    map_registry.increment(*bench::launder(&name));
+                }
+            });
+        });
+    }
+}
+
+#if __has_include(<fcntl.h>)
+// One response per iteration to /dev/null: the constant headers rebuilt by appending and sent
+// with write(), against the precomputed preamble sent with writev()
+void bench_http(bench::runner& runner) {
+    const int fd = ::open("/dev/null", O_WRONLY);
+    if (fd < 0) {
+        return;
+    }
+    const std::string body = R"({"status":"ok","items":[1,2,3]})";
+    runner.run("http/string_append", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            std::string response;
+            response += "HTTP/1.1 200 OK\r\n";
+            response += "Server: edge/1.4\r\n";
+            response += "Content-Type: application/json; charset=utf-8\r\n";
+            response += "Cache-Control: no-store\r\n";
+            response += "X-Content-Type-Options: nosniff\r\n";
+            response += "Strict-Transport-Security: max-age=63072000; includeSubDomains\r\n";
+            response += "Content-Length: ";
+            response += std::to_string(bench::launder(body).size());
+            response += "\r\n\r\n";
+            response += body;
+            bench::do_not_optimize(::write(fd, response.data(), response.size()));
+        }
+    });
+    runner.run("http/preamble_writev", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            const std::string& b = *bench::launder(&body);
+            char digits[24];
+            const auto length = std::to_chars(digits, digits + sizeof(digits), b.size());
+            const http_field fields[] = {{"Content-Length", std::string_view(digits, length.ptr)}};
+            bench::do_not_optimize(write_http_response(
+                fd,
+                http_preamble_v<http_status<200>, http_header<"Server", "edge/1.4">,
+                                http_header<"Content-Type", "application/json; charset=utf-8">,
+                                http_header<"Cache-Control", "no-store">, http_header<"X-Content-Type-Options", "nosniff">,
+                                http_header<"Strict-Transport-Security", "max-age=63072000; includeSubDomains">>,
+                fields, b));
+        }
+    });
+    ::close(fd);
+}
+#endif
+
+#if __has_include(<linux/io_uring.h>) && defined(O_DIRECT)
+// A 16 KiB canned response, written 32 times per submission to a temporary O_DIRECT file: the
+// kernel pins the four source pages for each plain write, and not at all for a fixed one.
+// Buffered files, pipes and sockets copy instead of pinning, so the difference is smaller there.
+constexpr auto canned_page = [] {
+    ct_string<16384> text{};
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        text.data[i] = static_cast<char>('a' + i % 26);
+    }
+    return text;
+}();
+
+void bench_uring(bench::runner& runner) {
+    using canned = fixed_payloads<canned_page>;
+    constexpr unsigned batch = 32;
+    uring_queue ring(batch);
+    char path[] = "/tmp/ct_string_bench_XXXXXX";
+    const int fd = ::mkostemp(path, O_DIRECT);
+    ::unlink(path);
+    if (!ring.valid() || fd < 0 || !canned::register_with(ring)) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return;
+    }
+    const auto drain = [&ring] {
+        ring.submit(batch);
+        for (unsigned reaped = 0; reaped < batch;) {
+            reaped += ring.reap([](std::uint64_t, int result) { bench::do_not_optimize(result); });
+        }
+    };
+    runner.run("uring/write_x32", [&](std::uint64_t n) {
+        const std::string_view text = canned::payload(0);
+        for (std::uint64_t i = 0; i < n; ++i) {
+            for (unsigned j = 0; j < batch; ++j) {
+                ring.prepare_write(fd, text.data(), static_cast<std::uint32_t>(text.size()), j, j * text.size());
+            }
+            drain();
+        }
+    });
+    runner.run("uring/write_fixed_x32", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            for (unsigned j = 0; j < batch; ++j) {
+                canned::prepare_write<canned_page>(ring, fd, j, j * canned_page.size());
+            }
+            drain();
+        }
+    });
+    ::close(fd);
+}
+#endif
+
+template<std::size_t... Lengths>
+void bench_lengths(bench::runner& runner, std::index_sequence<Lengths...>) {
+    (bench_comparisons<Lengths>(runner), ...);
+    (bench_conversions<Lengths>(runner), ...);
+    (bench_output<Lengths>(runner), ...);
+    (bench_hashing<Lengths>(runner), ...);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const auto opts = bench::parse_options(argc, argv);
+    if (!opts) return 2;
+
+    bench::runner runner(*opts);
+    runner.print_header();
+    bench_lengths(runner, std::index_sequence<1, 7, 8, 15, 16, 32, 64, 128, 256, 1024, 4096>{});
+    bench_logging(runner);
+    bench_metrics(runner);
+#if __has_include(<fcntl.h>)
+    bench_http(runner);
+#endif
+#if __has_include(<linux/io_uring.h>) && defined(O_DIRECT)
+    bench_uring(runner);
+#endif
+    return runner.finish() ? 0 : 1;
+}
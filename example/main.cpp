@@ -2,7 +2,11 @@
 #include <string>
 #include <string_view>
 
+#ifdef CT_STRING_HEADER_ONLY
+#include <ct_string/ct_string.hpp> // The header-only build
+#else
 import ct_string; // Import the module
+#endif
 
 // For compile-time assertions in examples (like Catch2's STATIC_REQUIRE)
 #define STATIC_ASSERT_MSG(cond, msg) static_assert(cond, msg)
@@ -0,0 +1,290 @@
+#pragma once
+
+// ASCII case mapping, case-insensitive comparison and hashing, ci_perfect_hash
+
+#include "ct_string.config.hpp"
+
+#ifndef CT_STRING_MODULE_INTERFACE
+#include "ct_string.core.hpp"
+#include <algorithm>   // For std::equal
+#include <array>
+#include <cstddef>
+#include <cstdint>     // For std::uint64_t
+#include <cstring>     // For std::memcpy in the word-at-a-time matchers
+#include <string_view>
+#include <type_traits> // For std::make_unsigned_t
+#include <bit>         // For std::bit_ceil
+#endif
+
+// --- ASCII case folding ---
+
+namespace ct_detail {
+
+// Case-insensitive comparison against a constant pattern that was folded ahead of time:
+// for every position, `(input | mask) == folded`, where mask is 0x20 at letter positions of
+// the pattern and 0 elsewhere. OR-ing 0x20 lowercases 'A'..'Z' and leaves 'a'..'z' alone;
+// it only ever matches the two cases of the pattern's own letter, and non-letters compare
+// exactly. Byte strings are processed eight bytes per step without branching on content.
+template<typename CharT>
+constexpr bool iequals_folded(const CharT* input, const std::make_unsigned_t<CharT>* folded,
+                              const std::make_unsigned_t<CharT>* mask, std::size_t n) {
+    using unit = std::make_unsigned_t<CharT>;
+    std::size_t i = 0;
+    if constexpr (sizeof(CharT) == 1) {
+        if (!std::is_constant_evaluated()) {
+            std::uint64_t diff = 0;
+            for (; i + 8 <= n; i += 8) {
+                std::uint64_t in_word;
+                std::uint64_t folded_word;
+                std::uint64_t mask_word;
+                std::memcpy(&in_word, input + i, 8);
+                std::memcpy(&folded_word, folded + i, 8);
+                std::memcpy(&mask_word, mask + i, 8);
+                diff |= (in_word | mask_word) ^ folded_word;
+            }
+            for (; i < n; ++i) {
+                diff |= static_cast<unit>(static_cast<unit>(input[i]) | mask[i]) ^ folded[i];
+            }
+            return diff == 0;
+        }
+    }
+    unit diff = 0;
+    for (; i < n; ++i) {
+        diff |= static_cast<unit>(static_cast<unit>(static_cast<unit>(input[i]) | mask[i]) ^ folded[i]);
+    }
+    return diff == 0;
+}
+
+// Lowercased copy of S plus the OR-mask used by iequals_folded
+template<ct_string S>
+struct folded_pattern {
+    using char_type = typename decltype(S)::value_type;
+    using unit = std::make_unsigned_t<char_type>;
+
+    static constexpr std::array<unit, S.size()> folded = [] {
+        std::array<unit, S.size()> out{};
+        for (std::size_t i = 0; i < S.size(); ++i) {
+            out[i] = static_cast<unit>(ascii_to_lower(S[i]));
+        }
+        return out;
+    }();
+
+    static constexpr std::array<unit, S.size()> mask = [] {
+        std::array<unit, S.size()> out{};
+        for (std::size_t i = 0; i < S.size(); ++i) {
+            out[i] = is_ascii_alpha(S[i]) ? unit{0x20} : unit{0};
+        }
+        return out;
+    }();
+};
+
+// Hash over ASCII-lowercased code units, so that keys differing only in case collide
+template<typename CharT>
+constexpr std::uint64_t ci_hash(const CharT* str, std::size_t n) {
+    using unit = std::make_unsigned_t<CharT>;
+    std::uint64_t h = 0xcbf29ce484222325ULL; // FNV-1a offset basis
+    for (std::size_t block = 0; block < n; block += constexpr_block) {
+        const std::size_t end = block_end(block, n);
+        for (std::size_t i = block; i < end; ++i) {
+            const auto c = static_cast<unit>(str[i]);
+            // Branch-free ASCII fold: adds 0x20 exactly when c is in 'A'..'Z'
+            const auto folded = c + 0x20 * static_cast<unit>(static_cast<unit>(c - unit('A')) < 26u);
+            h = (h ^ folded) * 0x100000001b3ULL; // FNV-1a prime
+        }
+    }
+    return h;
+}
+
+template<ct_string S, bool Upper>
+constexpr auto fold_case() {
+    auto result = S;
+    auto* out = result.data.data();
+    for (std::size_t block = 0; block < S.size(); block += constexpr_block) {
+        const std::size_t end = block_end(block, S.size());
+        for (std::size_t i = block; i < end; ++i) {
+            out[i] = Upper ? ascii_to_upper(out[i]) : ascii_to_lower(out[i]);
+        }
+    }
+    return result;
+}
+
+// Evaluated once per S, however many functions ask for the folded copy
+template<ct_string S, bool Upper>
+inline constexpr auto folded_case_v = fold_case<S, Upper>();
+
+} // namespace ct_detail
+
+// Copies of S with ASCII letters lowercased or uppercased. Other code units, including
+// non-ASCII letters, are left unchanged; this is the folding used by case-insensitive
+// protocol tokens such as HTTP header names and SQL keywords.
+CT_STRING_EXPORT template<ct_string S>
+constexpr auto to_lower() {
+    return ct_detail::folded_case_v<S, false>;
+}
+
+CT_STRING_EXPORT template<ct_string S>
+constexpr auto to_upper() {
+    return ct_detail::folded_case_v<S, true>;
+}
+
+// ASCII case-insensitive comparison of runtime input against a constant. The constant side
+// is folded at compile time, so only the input is touched at runtime.
+// Example: if (iequals<"content-length">(name)) { ... }
+CT_STRING_EXPORT template<ct_string S>
+constexpr bool iequals(std::basic_string_view<typename decltype(S)::value_type> input) {
+    using pattern = ct_detail::folded_pattern<S>;
+    return input.size() == S.size() &&
+           ct_detail::iequals_folded(input.data(), pattern::folded.data(), pattern::mask.data(), S.size());
+}
+
+// Compile-time perfect hash over a fixed set of keys, matched ASCII case-insensitively.
+// find() returns the index of the matching key in Keys..., or npos.
+// Example: using methods = ci_perfect_hash<"GET", "HEAD", "POST">;
+//          methods::find("post") == 2
+//
+// The table is built with hash-and-displace: keys are first hashed into buckets, then each
+// bucket gets a displacement that moves its keys onto free slots. A lookup costs one hash,
+// two table reads and one iequals against the candidate key.
+CT_STRING_EXPORT template<ct_string... Keys>
+struct ci_perfect_hash {
+    static_assert(sizeof...(Keys) > 0, "ci_perfect_hash: at least one key is required");
+
+    using char_type = std::common_type_t<typename decltype(Keys)::value_type...>;
+    static_assert((std::is_same_v<typename decltype(Keys)::value_type, char_type> && ...),
+                  "ci_perfect_hash: all keys must share a character type");
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    static constexpr std::size_t size = sizeof...(Keys);
+
+private:
+    using unit = std::make_unsigned_t<char_type>;
+
+    static constexpr std::size_t bucket_count = std::bit_ceil(size);
+    static constexpr std::size_t slot_count = std::bit_ceil(size + size / 2 + 1);
+    static constexpr int slot_shift = 64 - std::countr_zero(slot_count);
+
+    // Per-key data, indexed by the position of the key in Keys...
+    static constexpr std::uint64_t key_hashes[size] = {ct_detail::ci_hash(Keys.c_str(), Keys.size())...};
+    static constexpr std::size_t key_sizes[size] = {Keys.size()...};
+    static constexpr const unit* key_folded[size] = {ct_detail::folded_pattern<Keys>::folded.data()...};
+    static constexpr const unit* key_masks[size] = {ct_detail::folded_pattern<Keys>::mask.data()...};
+
+    static constexpr bool keys_unique() {
+        for (std::size_t a = 0; a < size; ++a) {
+            for (std::size_t b = a + 1; b < size; ++b) {
+                if (key_sizes[a] == key_sizes[b] &&
+                    std::equal(key_folded[a], key_folded[a] + key_sizes[a], key_folded[b])) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    static_assert(keys_unique(), "ci_perfect_hash: keys must be unique case-insensitively");
+
+    // Keys with the same full hash share a bucket and every slot, so no table separates them
+    static constexpr bool hashes_unique() {
+        for (std::size_t a = 0; a < size; ++a) {
+            for (std::size_t b = a + 1; b < size; ++b) {
+                if (key_hashes[a] == key_hashes[b]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    static_assert(!keys_unique() || hashes_unique(),
+                  "ci_perfect_hash: two distinct keys have the same 64-bit hash; remove or rename one of them");
+
+    // Displacements tried per bucket. Far more than random keys ever need, and within GCC's
+    // default limit of 262144 iterations per constexpr loop.
+    static constexpr std::uint32_t max_displacement = 1u << 16;
+
+    static constexpr std::size_t bucket_of(std::uint64_t h) {
+        return static_cast<std::size_t>(h >> 32) & (bucket_count - 1);
+    }
+
+    static constexpr std::size_t slot_of(std::uint64_t h, std::uint32_t displacement) {
+        // Multiply-shift over the displaced hash; with a single slot the shift would be 64
+        const std::uint64_t mixed = (h ^ (displacement * 0x9E3779B97F4A7C15ULL)) * 0xBF58476D1CE4E5B9ULL;
+        return slot_shift >= 64 ? 0 : static_cast<std::size_t>(mixed >> slot_shift);
+    }
+
+    struct table {
+        std::array<std::uint32_t, bucket_count> displacement{};
+        std::array<std::size_t, slot_count> slot_to_key{};
+        bool complete = true; // False if some bucket found no displacement
+    };
+
+    static constexpr table build() {
+        table t{};
+        for (auto& s : t.slot_to_key) {
+            s = npos;
+        }
+        if (!keys_unique() || !hashes_unique()) {
+            return t; // Such keys would never fit; the static_asserts above report them
+        }
+        std::array<std::size_t, bucket_count> bucket_sizes{};
+        for (std::size_t k = 0; k < size; ++k) {
+            ++bucket_sizes[bucket_of(key_hashes[k])];
+        }
+        // Place the largest buckets first, they are the hardest to fit
+        for (std::size_t want = size; want > 0; --want) {
+            for (std::size_t b = 0; b < bucket_count; ++b) {
+                if (bucket_sizes[b] != want) {
+                    continue;
+                }
+                bool placed = false;
+                for (std::uint32_t d = 0; d < max_displacement && !placed; ++d) {
+                    std::array<std::size_t, size> taken{};
+                    std::size_t taken_count = 0;
+                    bool fits = true;
+                    for (std::size_t k = 0; k < size && fits; ++k) {
+                        if (bucket_of(key_hashes[k]) != b) {
+                            continue;
+                        }
+                        const std::size_t s = slot_of(key_hashes[k], d);
+                        fits = t.slot_to_key[s] == npos;
+                        for (std::size_t j = 0; j < taken_count && fits; ++j) {
+                            fits = taken[j] != s;
+                        }
+                        taken[taken_count++] = s;
+                    }
+                    if (fits) {
+                        t.displacement[b] = d;
+                        std::size_t j = 0;
+                        for (std::size_t k = 0; k < size; ++k) {
+                            if (bucket_of(key_hashes[k]) == b) {
+                                t.slot_to_key[taken[j++]] = k;
+                            }
+                        }
+                        placed = true;
+                    }
+                }
+                if (!placed) {
+                    t.complete = false;
+                    return t;
+                }
+            }
+        }
+        return t;
+    }
+
+    static constexpr table lookup = build();
+    static_assert(lookup.complete, "ci_perfect_hash: no collision-free table found for these keys");
+
+public:
+    static constexpr std::size_t find(std::basic_string_view<char_type> key) {
+        const std::uint64_t h = ct_detail::ci_hash(key.data(), key.size());
+        const std::size_t index = lookup.slot_to_key[slot_of(h, lookup.displacement[bucket_of(h)])];
+        if (index == npos || key.size() != key_sizes[index] ||
+            !ct_detail::iequals_folded(key.data(), key_folded[index], key_masks[index], key.size())) {
+            return npos;
+        }
+        return index;
+    }
+
+    static constexpr bool contains(std::basic_string_view<char_type> key) {
+        return find(key) != npos;
+    }
+};
@@ -0,0 +1,19 @@
+module;
+
+#include <algorithm>   // For std::equal
+#include <array>
+#include <cstddef>
+#include <cstdint>     // For std::uint64_t
+#include <cstring>     // For std::memcpy in the word-at-a-time matchers
+#include <string_view>
+#include <type_traits> // For std::make_unsigned_t
+#include <bit>         // For std::bit_ceil
+
+#define CT_STRING_MODULE_INTERFACE
+
+export module ct_string.ascii;
+
+export import ct_string.core;
+
+// ct_string.ascii.hpp with its public declarations exported
+#include "ct_string.ascii.hpp"
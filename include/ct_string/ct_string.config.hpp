@@ -0,0 +1,21 @@
+#pragma once
+
+// Macros shared by the ct_string headers. The ct_string*.ixx module interfaces define
+// CT_STRING_MODULE_INTERFACE before including the headers of the same name; without it the
+// headers form the header-only library.
+
+#ifdef CT_STRING_MODULE_INTERFACE
+#define CT_STRING_EXPORT export
+// Runtime kernels are emitted once, in the module's object file
+#define CT_STRING_KERNEL
+#else
+#define CT_STRING_EXPORT
+#define CT_STRING_KERNEL inline
+#endif
+
+// Thin wrappers over out-of-line kernels are forced inline so they leave no per-length code
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CT_STRING_ALWAYS_INLINE __forceinline
+#else
+#define CT_STRING_ALWAYS_INLINE [[gnu::always_inline]] inline
+#endif
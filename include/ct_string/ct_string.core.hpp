@@ -0,0 +1,498 @@
+#pragma once
+
+// The ct_string type with its conversions, comparisons, concatenation, find, hashing and
+// stream output. Depends on no other ct_string module and on as few standard headers as the
+// type itself needs; the algorithms live in ct_string.ascii, .unicode, .format and .hash, and
+// ct_here in ct_string.source.
+
+#include "ct_string.config.hpp"
+
+#ifndef CT_STRING_MODULE_INTERFACE
+#include <array>
+#include <iosfwd>      // Declares std::basic_string and std::basic_ostream; users who convert or print include them
+#include <string_view>
+#include <cstddef>
+#include <compare>   // For <=>
+#include <concepts>    // For std::same_as
+#include <type_traits> // For std::type_identity_t
+#include <cstring>     // For std::memcmp in the runtime kernels
+#endif
+
+// Character types ct_string can be instantiated with (the same set std::basic_string supports)
+CT_STRING_EXPORT template<typename CharT>
+concept ct_char = std::same_as<CharT, char> || std::same_as<CharT, wchar_t> ||
+                  std::same_as<CharT, char8_t> || std::same_as<CharT, char16_t> ||
+                  std::same_as<CharT, char32_t>;
+
+// Shared with the other ct_string modules, which is the only reason these are exported;
+// they are not part of the public interface.
+CT_STRING_EXPORT namespace ct_detail {
+
+inline constexpr std::size_t constexpr_block = 65536;
+
+// End of the block that starts at `block` in a blocked loop over n units
+constexpr std::size_t block_end(std::size_t block, std::size_t n) {
+    return n - block < constexpr_block ? n : block + constexpr_block;
+}
+
+template<typename CharT>
+constexpr CharT ascii_to_lower(CharT c) {
+    return (c >= CharT('A') && c <= CharT('Z')) ? static_cast<CharT>(c + ('a' - 'A')) : c;
+}
+
+template<typename CharT>
+constexpr CharT ascii_to_upper(CharT c) {
+    return (c >= CharT('a') && c <= CharT('z')) ? static_cast<CharT>(c - ('a' - 'A')) : c;
+}
+
+template<typename CharT>
+constexpr bool is_ascii_alpha(CharT c) {
+    return ascii_to_lower(c) >= CharT('a') && ascii_to_lower(c) <= CharT('z');
+}
+
+} // namespace ct_detail
+
+// --- Constant-evaluation kernels ---
+// The compile-time side of copying, comparing and searching. Every algorithm is a single linear
+// pass, and every loop over a whole string runs in blocks of constexpr_block code units: GCC
+// caps each loop at -fconstexpr-loop-limit iterations (262144 by default) independently of the
+// total work, so a flat loop fails at 256 KiB while the same work split into blocks only counts
+// against the overall budget (-fconstexpr-ops-limit, Clang's -fconstexpr-steps, MSVC's
+// /constexpr:steps). README.md lists the budgets megabyte-sized strings need.
+// At runtime the kernels defer to std::char_traits and std::basic_string_view, which use
+// memcpy/memcmp/memchr.
+
+namespace ct_detail {
+
+template<typename CharT>
+constexpr void copy_units(const CharT* from, std::size_t n, CharT* to) {
+    if (!std::is_constant_evaluated()) {
+        std::char_traits<CharT>::copy(to, from, n);
+        return;
+    }
+    for (std::size_t block = 0; block < n; block += constexpr_block) {
+        const std::size_t end = block_end(block, n);
+        for (std::size_t i = block; i < end; ++i) {
+            to[i] = from[i];
+        }
+    }
+}
+
+// Three-way comparison with the semantics of std::char_traits<CharT>::compare plus a length tiebreak
+template<typename CharT>
+constexpr int compare_units(const CharT* lhs, std::size_t lhs_size, const CharT* rhs, std::size_t rhs_size) {
+    using traits = std::char_traits<CharT>;
+    const std::size_t n = lhs_size < rhs_size ? lhs_size : rhs_size;
+    for (std::size_t block = 0; block < n; block += constexpr_block) {
+        const std::size_t end = block_end(block, n);
+        for (std::size_t i = block; i < end; ++i) {
+            // Built-in != per unit, the traits call only on the first mismatch
+            if (lhs[i] != rhs[i]) {
+                return traits::lt(lhs[i], rhs[i]) ? -1 : 1;
+            }
+        }
+    }
+    return lhs_size < rhs_size ? -1 : lhs_size > rhs_size ? 1 : 0;
+}
+
+template<typename CharT>
+constexpr bool equal_units(const CharT* lhs, std::size_t lhs_size, const CharT* rhs, std::size_t rhs_size) {
+    return lhs_size == rhs_size && compare_units(lhs, lhs_size, rhs, rhs_size) == 0;
+}
+
+template<typename CharT>
+constexpr std::size_t c_str_length(const CharT* str) {
+    if (!std::is_constant_evaluated()) {
+        return std::char_traits<CharT>::length(str);
+    }
+    std::size_t n = 0;
+    for (bool done = false; !done;) {
+        for (const std::size_t end = n + constexpr_block; n < end; ++n) {
+            if (str[n] == CharT{}) {
+                done = true;
+                break;
+            }
+        }
+    }
+    return n;
+}
+
+// Knuth-Morris-Pratt: O(n + m) in the worst case, where std::basic_string_view::find is
+// O(n * m). The failure table is a transient new[] of m entries, value-initialized in one step
+// rather than through a std::vector's construct_at call per entry.
+template<typename CharT>
+constexpr std::size_t find_units(const CharT* str, std::size_t n, const CharT* needle, std::size_t m,
+                                 std::size_t pos) {
+    constexpr auto npos = static_cast<std::size_t>(-1);
+    if (!std::is_constant_evaluated()) {
+        return std::basic_string_view<CharT>(str, n).find(std::basic_string_view<CharT>(needle, m), pos);
+    }
+    if (pos > n || m > n - pos) {
+        return npos;
+    }
+    if (m == 0) {
+        return pos;
+    }
+    // failure[i]: length of the longest proper border of needle[0..i]
+    std::size_t* failure = new std::size_t[m]{};
+    for (std::size_t block = 1, k = 0; block < m; block += constexpr_block) {
+        const std::size_t end = block_end(block, m);
+        for (std::size_t i = block; i < end; ++i) {
+            while (k > 0 && needle[i] != needle[k]) {
+                k = failure[k - 1];
+            }
+            if (needle[i] == needle[k]) {
+                ++k;
+            }
+            failure[i] = k;
+        }
+    }
+    for (std::size_t block = pos, k = 0; block < n; block += constexpr_block) {
+        const std::size_t end = block_end(block, n);
+        for (std::size_t i = block; i < end; ++i) {
+            while (k > 0 && str[i] != needle[k]) {
+                k = failure[k - 1];
+            }
+            if (str[i] == needle[k] && ++k == m) {
+                delete[] failure;
+                return i + 1 - m;
+            }
+        }
+    }
+    delete[] failure;
+    return npos;
+}
+
+} // namespace ct_detail
+// N is the number of characters (excluding null terminator), CharT the code unit type.
+// CharT is the trailing parameter so that ct_string<5> and ct_string<> keep meaning char.
+CT_STRING_EXPORT template<std::size_t N = 0, ct_char CharT = char>
+struct ct_string {
+    using value_type = CharT;
+    using view_type = std::basic_string_view<CharT>;
+    using string_type = std::basic_string<CharT>;
+
+    // Store N characters + 1 null terminator
+    std::array<CharT, N + 1> data;
+
+    // Default constructor: Creates an empty string
+    constexpr ct_string() : data{} {
+        // Ensure null termination even for default constructor
+        if constexpr (N == 0) {
+            data[0] = CharT{};
+        }
+        // For N > 0, zero-initialization already sets null terminators
+    }
+
+    // Constructor from C-style string literal
+    // Requires literal of size N+1 (N chars + null terminator)
+    constexpr ct_string(const CharT (&str)[N + 1]) {
+        // Copies N+1 elements, including the null terminator (std::copy at runtime, in blocks
+        // during constant evaluation so that large literals stay within the loop limits)
+        ct_detail::copy_units(str, N + 1, data.data());
+        // Ensure the last element is null, even if the literal wasn't proper
+        // (though the array size constraint should guarantee it)
+        data[N] = CharT{};
+    }
+
+    // Return size excluding null terminator (standard behavior)
+    constexpr std::size_t size() const { return N; }
+    constexpr std::size_t length() const { return N; } // Alias
+    constexpr bool empty() const { return N == 0; }
+
+    // Access as const CharT* (null-terminated)
+    CT_STRING_ALWAYS_INLINE constexpr const CharT* c_str() const { return data.data(); }
+    constexpr const CharT* get_data() const { return data.data(); } // Alias
+
+    // Conversion to string_view (efficient, constexpr-friendly)
+    CT_STRING_ALWAYS_INLINE constexpr operator view_type() const {
+        return view_type(data.data(), N); // Use N, not N+1
+    }
+
+    // Conversion to std::string (potentially allocates, less constexpr-friendly)
+    // This provides seamless conversion where std::string is required at runtime. Only
+    // instantiated when used, so <string> is needed where the conversion is, not here.
+    /*constexpr*/ // std::string construction might not be fully constexpr pre-C++20/23
+    CT_STRING_ALWAYS_INLINE operator string_type() const {
+        return string_type(data.data(), N); // Use N, not N+1
+    }
+
+    // Conversion to const CharT*
+    CT_STRING_ALWAYS_INLINE constexpr operator const CharT*() const {
+        return data.data();
+    }
+
+    // Const access operator. Add bounds checking if desired.
+    CT_STRING_ALWAYS_INLINE constexpr const CharT& operator[](std::size_t index) const {
+        // Optional: Add bounds check
+        // if (index >= N) throw std::out_of_range("ct_string index out of range");
+        return data[index];
+    }
+
+    // Iterators (optional but good for range-based for loops)
+    CT_STRING_ALWAYS_INLINE constexpr const CharT* begin() const { return data.data(); }
+    CT_STRING_ALWAYS_INLINE constexpr const CharT* end() const { return data.data() + N; } // Points one past the last char
+
+    static constexpr std::size_t npos = view_type::npos;
+
+    // Position of the first occurrence of str at or after pos, or npos. Linear in size() + str.size()
+    // during constant evaluation; std::basic_string_view::find at runtime.
+    constexpr std::size_t find(view_type str, std::size_t pos = 0) const {
+        return ct_detail::find_units(data.data(), N, str.data(), str.size(), pos);
+    }
+
+    constexpr bool contains(view_type str) const { return find(str) != npos; }
+};
+
+// Deduction guide to automatically deduce N and the character type from a string literal
+// Example: ct_string myStr = "Hello";   // Deduces ct_string<5, char>
+//          ct_string wide = u"Hello";   // Deduces ct_string<5, char16_t>
+// Also covers u8"", U"" and L"" literals.
+CT_STRING_EXPORT template<ct_char CharT, std::size_t N_with_null>
+ct_string(const CharT (&str)[N_with_null]) -> ct_string<N_with_null - 1, CharT>;
+
+// std-style spelling with the character type first: basic_ct_string<char16_t, 5>
+CT_STRING_EXPORT template<ct_char CharT, std::size_t N = 0>
+using basic_ct_string = ct_string<N, CharT>;
+
+// Named aliases mirroring std::u8string, std::u16string, ...
+CT_STRING_EXPORT template<std::size_t N = 0> using wct_string = ct_string<N, wchar_t>;
+CT_STRING_EXPORT template<std::size_t N = 0> using u8ct_string = ct_string<N, char8_t>;
+CT_STRING_EXPORT template<std::size_t N = 0> using u16ct_string = ct_string<N, char16_t>;
+CT_STRING_EXPORT template<std::size_t N = 0> using u32ct_string = ct_string<N, char32_t>;
+
+// --- Operators ---
+
+// Concatenation operator (both sides must share the same character type)
+CT_STRING_EXPORT template<std::size_t N1, std::size_t N2, typename CharT>
+constexpr auto operator+ (const ct_string<N1, CharT>& lhs, const ct_string<N2, CharT>& rhs) {
+    ct_string<N1 + N2, CharT> result{}; // Result has N1+N2 chars + null
+
+    // Copy characters from lhs (N1 chars)
+    ct_detail::copy_units(lhs.data.data(), N1, result.data.data());
+    // Copy characters from rhs (N2 chars) and its null terminator
+    ct_detail::copy_units(rhs.data.data(), N2 + 1, result.data.data() + N1);
+    // The null terminator from rhs is now at result.data[N1 + N2]
+
+    return result;
+}
+
+// Comparison operators
+// Constant evaluation uses the blocked kernels above. At runtime the operators are
+// force-inlined wrappers: short strings (up to inline_compare_limit code units) compare with a
+// fixed-size memcmp the compiler expands in place, longer char strings call the non-template
+// kernels in ct_detail, so no out-of-line code is emitted per length or length pair.
+// The non-ct_string side is wrapped in std::type_identity_t so CharT is deduced from the
+// ct_string alone; this keeps comparisons against nullptr and string literals working.
+
+namespace ct_detail {
+
+inline constexpr std::size_t inline_compare_limit = 16;
+
+// Runtime kernels shared by all lengths; defined once in the module's object file, or inline
+// in the header-only build
+CT_STRING_KERNEL bool equal_bytes(const void* lhs, const void* rhs, std::size_t bytes) noexcept {
+    return std::memcmp(lhs, rhs, bytes) == 0;
+}
+
+// Equality of n chars with a null-terminated string, without a separate strlen pass
+CT_STRING_KERNEL bool equal_c_str(const char* str, std::size_t n, const char* c_str) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (c_str[i] != str[i] || c_str[i] == '\0') {
+            return false;
+        }
+    }
+    return c_str[n] == '\0';
+}
+
+CT_STRING_KERNEL int compare_chars(const char* lhs, std::size_t lhs_size, const char* rhs, std::size_t rhs_size) noexcept {
+    return std::string_view(lhs, lhs_size).compare(std::string_view(rhs, rhs_size));
+}
+
+CT_STRING_KERNEL std::size_t hash_chars(const char* str, std::size_t n) noexcept {
+    return std::hash<std::string_view>{}(std::string_view(str, n));
+}
+
+// Runtime equality of the N code units at lhs with rhs
+template<std::size_t N, typename CharT>
+CT_STRING_ALWAYS_INLINE bool equal_runtime(const CharT* lhs, std::basic_string_view<CharT> rhs) noexcept {
+    if (rhs.size() != N) {
+        return false;
+    }
+    if constexpr (N == 0) {
+        return true;
+    } else if constexpr (N <= inline_compare_limit) {
+        return std::memcmp(lhs, rhs.data(), N * sizeof(CharT)) == 0;
+    } else {
+        return equal_bytes(lhs, rhs.data(), N * sizeof(CharT));
+    }
+}
+
+// Runtime three-way comparison of the N code units at lhs with rhs
+template<std::size_t N, typename CharT>
+CT_STRING_ALWAYS_INLINE std::strong_ordering compare_runtime(const CharT* lhs, std::basic_string_view<CharT> rhs) noexcept {
+    if constexpr (std::same_as<CharT, char> && N > inline_compare_limit) {
+        return compare_chars(lhs, N, rhs.data(), rhs.size()) <=> 0;
+    } else {
+        return std::basic_string_view<CharT>(lhs, N) <=> rhs;
+    }
+}
+
+} // namespace ct_detail
+
+// ct_string == ct_string
+CT_STRING_EXPORT template<std::size_t N1, std::size_t N2, typename CharT>
+CT_STRING_ALWAYS_INLINE constexpr bool operator==(const ct_string<N1, CharT>& lhs, const ct_string<N2, CharT>& rhs) {
+    using sv = std::basic_string_view<CharT>;
+    if (std::is_constant_evaluated()) {
+        return ct_detail::equal_units(lhs.c_str(), N1, rhs.c_str(), N2);
+    }
+    if constexpr (N1 != N2) {
+        return false;
+    } else {
+        return ct_detail::equal_runtime<N1>(lhs.c_str(), sv(rhs));
+    }
+}
+
+// ct_string == string_view
+CT_STRING_EXPORT template<std::size_t N, typename CharT>
+CT_STRING_ALWAYS_INLINE constexpr bool operator==(const ct_string<N, CharT>& lhs, std::type_identity_t<std::basic_string_view<CharT>> rhs) {
+    if (std::is_constant_evaluated()) {
+        return ct_detail::equal_units(lhs.c_str(), N, rhs.data(), rhs.size());
+    }
+    return ct_detail::equal_runtime<N>(lhs.c_str(), rhs);
+}
+// string_view == ct_string (symmetric)
+CT_STRING_EXPORT template<std::size_t N, typename CharT>
+CT_STRING_ALWAYS_INLINE constexpr bool operator==(std::type_identity_t<std::basic_string_view<CharT>> lhs, const ct_string<N, CharT>& rhs) {
+    return rhs == lhs;
+}
+
+CT_STRING_EXPORT template<std::size_t N, typename CharT>
+CT_STRING_ALWAYS_INLINE constexpr bool operator==(const ct_string<N, CharT>& lhs, std::type_identity_t<const CharT*> rhs) {
+    if (!rhs) {
+        return N == 0 && *lhs.c_str() == CharT{}; // Handle nullptr rhs
+    }
+    if (std::is_constant_evaluated()) {
+        return ct_detail::equal_units(lhs.c_str(), N, rhs, ct_detail::c_str_length(rhs));
+    }
+    if constexpr (std::same_as<CharT, char>) {
+        return ct_detail::equal_c_str(lhs.c_str(), N, rhs);
+    } else {
+        return ct_detail::equal_runtime<N>(lhs.c_str(), std::basic_string_view<CharT>(rhs));
+    }
+}
+CT_STRING_EXPORT template<std::size_t N, typename CharT>
+CT_STRING_ALWAYS_INLINE constexpr bool operator==(std::type_identity_t<const CharT*> lhs, const ct_string<N, CharT>& rhs) {
+    return rhs == lhs;
+}
+
+
+// Optional: Add != operators (usually defaulted in C++20, but explicit here for clarity)
+CT_STRING_EXPORT template<std::size_t N1, std::size_t N2, typename CharT>
+CT_STRING_ALWAYS_INLINE constexpr bool operator!=(const ct_string<N1, CharT>& lhs, const ct_string<N2, CharT>& rhs) {
+    return !(lhs == rhs);
+}
+CT_STRING_EXPORT template<std::size_t N, typename CharT>
+CT_STRING_ALWAYS_INLINE constexpr bool operator!=(const ct_string<N, CharT>& lhs, std::type_identity_t<std::basic_string_view<CharT>> rhs) {
+    return !(lhs == rhs);
+}
+CT_STRING_EXPORT template<std::size_t N, typename CharT>
+CT_STRING_ALWAYS_INLINE constexpr bool operator!=(std::type_identity_t<std::basic_string_view<CharT>> lhs, const ct_string<N, CharT>& rhs) {
+    return !(lhs == rhs);
+}
+CT_STRING_EXPORT template<std::size_t N, typename CharT>
+CT_STRING_ALWAYS_INLINE constexpr bool operator!=(const ct_string<N, CharT>& lhs, std::type_identity_t<const CharT*> rhs) {
+    return !(lhs == rhs);
+}
+CT_STRING_EXPORT template<std::size_t N, typename CharT>
+CT_STRING_ALWAYS_INLINE constexpr bool operator!=(std::type_identity_t<const CharT*> lhs, const ct_string<N, CharT>& rhs) {
+    return !(lhs == rhs);
+}
+
+// C++20 Three-Way Comparison (operator<=>)
+// This will also generate <, <=, >, >= operators.
+CT_STRING_EXPORT template<std::size_t N1, std::size_t N2, typename CharT>
+CT_STRING_ALWAYS_INLINE constexpr auto operator<=>(const ct_string<N1, CharT>& lhs, const ct_string<N2, CharT>& rhs) {
+    using sv = std::basic_string_view<CharT>;
+    if (std::is_constant_evaluated()) {
+        return ct_detail::compare_units(lhs.c_str(), N1, rhs.c_str(), N2) <=> 0;
+    }
+    return ct_detail::compare_runtime<N1>(lhs.c_str(), sv(rhs));
+}
+CT_STRING_EXPORT template<std::size_t N, typename CharT>
+CT_STRING_ALWAYS_INLINE constexpr auto operator<=>(const ct_string<N, CharT>& lhs, std::type_identity_t<std::basic_string_view<CharT>> rhs) {
+    if (std::is_constant_evaluated()) {
+        return ct_detail::compare_units(lhs.c_str(), N, rhs.data(), rhs.size()) <=> 0;
+    }
+    return ct_detail::compare_runtime<N>(lhs.c_str(), rhs);
+}
+CT_STRING_EXPORT template<std::size_t N, typename CharT>
+CT_STRING_ALWAYS_INLINE constexpr auto operator<=>(const ct_string<N, CharT>& lhs, std::type_identity_t<const CharT*> rhs) {
+    constexpr CharT empty[1] = {};
+    const CharT* str = rhs ? rhs : empty; // Handle nullptr rhs
+    return lhs <=> std::basic_string_view<CharT>(str, ct_detail::c_str_length(str));
+}
+
+// Stream output writes all N code units (like std::string, embedded nulls included). Only
+// declared against <iosfwd>: the caller's <ostream> or <iostream> completes the stream.
+CT_STRING_EXPORT template<std::size_t N, typename CharT, typename Traits>
+CT_STRING_ALWAYS_INLINE std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const ct_string<N, CharT>& str) {
+    return os << std::basic_string_view<CharT, Traits>(str.c_str(), N);
+}
+
+// Hashes equal those of std::basic_string_view<CharT>, so ct_string keys can be looked up
+// with string_views in containers using std::hash<std::string_view>
+template<std::size_t N, typename CharT>
+struct std::hash<ct_string<N, CharT>> {
+    CT_STRING_ALWAYS_INLINE std::size_t operator()(const ct_string<N, CharT>& str) const noexcept {
+        if constexpr (std::same_as<CharT, char>) {
+            return ct_detail::hash_chars(str.c_str(), N);
+        } else {
+            return std::hash<std::basic_string_view<CharT>>{}(str);
+        }
+    }
+};
+
+// --- Cached derivations ---
+
+// The result of Derive(Inputs...), evaluated once per TU for each distinct set of inputs and
+// emitted at most once per program: an inline variable is merged by the linker like any other.
+// Use it for large tables derived from ct_string constants (perfect-hash tables, automata,
+// string pools) that several functions need, instead of deriving the table in each of them:
+//   inline constexpr auto build_keyword_index = [](const auto&... keywords) { ... };
+//   constexpr const auto& index = ct_cached<build_keyword_index, "if", "else", "while">;
+// Derive must be a constant without captures (a lambda or function object), and is part of the
+// key: name it once and reuse the name, as two lambda expressions are always distinct keys.
+CT_STRING_EXPORT template<auto Derive, ct_string... Inputs>
+inline constexpr auto ct_cached = Derive(Inputs...);
+
+// --- Embedded resources ---
+
+// Wraps the bytes of an embedded file as a ct_string constant. `bytes` is the array declared
+// by a ct_string_embed() header (see README.md), or any array initialized from #embed with a
+// terminating 0 appended:
+//   #include "shader_glsl.hpp"   // inline constexpr unsigned char shader_glsl[] = {...};
+//   constexpr auto shader = from_embedded(shader_glsl);
+//   constexpr auto shader_id = crc32_v<shader>;
+// The file contents are copied verbatim; embedded nulls are kept and the terminator is dropped.
+// from_embedded<char8_t>(bytes) gives a u8ct_string instead.
+CT_STRING_EXPORT template<ct_char CharT, std::size_t N_with_null>
+    requires(sizeof(CharT) == 1)
+constexpr ct_string<N_with_null - 1, CharT> from_embedded(const unsigned char (&bytes)[N_with_null]) {
+    ct_string<N_with_null - 1, CharT> result{};
+    CharT* out = result.data.data();
+    for (std::size_t block = 0; block < N_with_null - 1; block += ct_detail::constexpr_block) {
+        const std::size_t end = ct_detail::block_end(block, N_with_null - 1);
+        for (std::size_t i = block; i < end; ++i) {
+            out[i] = static_cast<CharT>(bytes[i]);
+        }
+    }
+    return result;
+}
+
+// An overload rather than a default for CharT, which would precede the deduced N_with_null
+CT_STRING_EXPORT template<std::size_t N_with_null>
+constexpr ct_string<N_with_null - 1> from_embedded(const unsigned char (&bytes)[N_with_null]) {
+    return from_embedded<char>(bytes);
+}
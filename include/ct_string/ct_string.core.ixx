@@ -0,0 +1,17 @@
+module;
+
+#include <array>
+#include <iosfwd>      // Declares std::basic_string and std::basic_ostream; users who convert or print include them
+#include <string_view>
+#include <cstddef>
+#include <compare>   // For <=>
+#include <concepts>    // For std::same_as
+#include <type_traits> // For std::type_identity_t
+#include <cstring>     // For std::memcmp in the runtime kernels
+
+#define CT_STRING_MODULE_INTERFACE
+
+export module ct_string.core;
+
+// ct_string.core.hpp with its public declarations exported
+#include "ct_string.core.hpp"
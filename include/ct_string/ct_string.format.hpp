@@ -0,0 +1,1043 @@
+#pragma once
+
+// Conversions between text and values: integer and floating-point parsing, shortest
+// round-trip float formatting, hex, base64 and UUID encoding
+
+#include "ct_string.config.hpp"
+
+#ifndef CT_STRING_MODULE_INTERFACE
+#include "ct_string.core.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <bit>         // For std::bit_cast, std::countl_zero
+#include <charconv>    // For std::from_chars in the runtime parsers
+#include <concepts>
+#include <limits>      // For std::numeric_limits
+#include <optional>    // For the runtime parsers' results
+#include <string_view>
+#include <utility>     // For std::pair
+#include <vector>      // For the big integers of exact float conversion
+#endif
+
+// --- Numeric parsing ---
+
+// Why a parse failed
+CT_STRING_EXPORT enum class parse_error { none, empty, invalid_character, out_of_range };
+
+namespace ct_detail {
+
+template<typename T>
+struct parse_result {
+    T value{};
+    parse_error error = parse_error::none;
+};
+
+// Value of an ASCII digit or letter in bases up to 36, or 36 for anything else
+template<typename CharT>
+constexpr unsigned digit_value(CharT c) {
+    if (c >= CharT('0') && c <= CharT('9')) {
+        return static_cast<unsigned>(c - CharT('0'));
+    }
+    const CharT lower = ascii_to_lower(c);
+    if (lower >= CharT('a') && lower <= CharT('z')) {
+        return static_cast<unsigned>(lower - CharT('a')) + 10;
+    }
+    return 36;
+}
+
+// Integer grammar of std::from_chars: an optional '-' (signed types only) followed by one or
+// more digits of the base, letters in either case. No '+', whitespace or base prefix; the
+// whole input has to be consumed.
+template<std::integral T, typename CharT>
+constexpr parse_result<T> parse_integer(const CharT* str, std::size_t n, int base) {
+    parse_result<T> result;
+    std::size_t i = 0;
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        if (n > 0 && str[0] == CharT('-')) {
+            negative = true;
+            ++i;
+        }
+    }
+    if (i == n) {
+        result.error = parse_error::empty;
+        return result;
+    }
+    // Accumulate the magnitude as unsigned; a negative result may reach |min|
+    using U = std::make_unsigned_t<T>;
+    const U limit = negative ? static_cast<U>(static_cast<U>(std::numeric_limits<T>::max()) + 1)
+                             : static_cast<U>(std::numeric_limits<T>::max());
+    U magnitude = 0;
+    bool overflow = false;
+    for (; i < n; ++i) {
+        const unsigned d = digit_value(str[i]);
+        if (d >= static_cast<unsigned>(base)) {
+            result.error = parse_error::invalid_character;
+            return result;
+        }
+        if (magnitude > (limit - d) / static_cast<U>(base)) {
+            overflow = true; // Keep scanning: an invalid character takes precedence
+        } else {
+            magnitude = static_cast<U>(magnitude * static_cast<U>(base) + d);
+        }
+    }
+    if (overflow) {
+        result.error = parse_error::out_of_range;
+        return result;
+    }
+    result.value = negative ? static_cast<T>(0 - magnitude) : static_cast<T>(magnitude);
+    return result;
+}
+
+// Arbitrary-precision unsigned integer for exact decimal <-> binary floating-point conversion
+// in constant expressions. Little-endian 32-bit limbs.
+struct big_uint {
+    std::vector<std::uint32_t> limbs;
+
+    constexpr big_uint() = default;
+    constexpr explicit big_uint(std::uint64_t value) {
+        while (value != 0) {
+            limbs.push_back(static_cast<std::uint32_t>(value));
+            value >>= 32;
+        }
+    }
+
+    constexpr bool is_zero() const { return limbs.empty(); }
+
+    constexpr std::size_t bit_length() const {
+        return limbs.empty() ? 0 : (limbs.size() - 1) * 32 + std::bit_width(limbs.back());
+    }
+
+    constexpr bool bit(std::size_t index) const {
+        return index / 32 < limbs.size() && ((limbs[index / 32] >> (index % 32)) & 1) != 0;
+    }
+
+    constexpr void trim() {
+        while (!limbs.empty() && limbs.back() == 0) {
+            limbs.pop_back();
+        }
+    }
+
+    constexpr big_uint& mul_add(std::uint32_t factor, std::uint32_t addend = 0) {
+        std::uint64_t carry = addend;
+        for (auto& limb : limbs) {
+            const std::uint64_t product = static_cast<std::uint64_t>(limb) * factor + carry;
+            limb = static_cast<std::uint32_t>(product);
+            carry = product >> 32;
+        }
+        if (carry != 0) {
+            limbs.push_back(static_cast<std::uint32_t>(carry));
+        }
+        trim();
+        return *this;
+    }
+
+    constexpr big_uint& mul_pow10(std::size_t exponent) {
+        for (; exponent >= 9; exponent -= 9) {
+            mul_add(1'000'000'000);
+        }
+        constexpr std::uint32_t small_powers[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+        return mul_add(small_powers[exponent]);
+    }
+
+    constexpr big_uint& shift_left(std::size_t bits) {
+        if (is_zero() || bits == 0) {
+            return *this;
+        }
+        const std::size_t limb_shift = bits / 32;
+        const unsigned bit_shift = bits % 32;
+        limbs.insert(limbs.begin(), limb_shift, 0);
+        if (bit_shift != 0) {
+            std::uint32_t carry = 0;
+            for (std::size_t i = limb_shift; i < limbs.size(); ++i) {
+                const std::uint32_t next = limbs[i] >> (32 - bit_shift);
+                limbs[i] = (limbs[i] << bit_shift) | carry;
+                carry = next;
+            }
+            if (carry != 0) {
+                limbs.push_back(carry);
+            }
+        }
+        return *this;
+    }
+
+    // *this -= other; requires *this >= other
+    constexpr big_uint& subtract(const big_uint& other) {
+        std::int64_t borrow = 0;
+        for (std::size_t i = 0; i < limbs.size(); ++i) {
+            std::int64_t diff = static_cast<std::int64_t>(limbs[i]) - borrow -
+                                (i < other.limbs.size() ? static_cast<std::int64_t>(other.limbs[i]) : 0);
+            borrow = diff < 0 ? 1 : 0;
+            limbs[i] = static_cast<std::uint32_t>(diff + (borrow << 32));
+        }
+        trim();
+        return *this;
+    }
+
+    friend constexpr std::strong_ordering operator<=>(const big_uint& lhs, const big_uint& rhs) {
+        if (lhs.limbs.size() != rhs.limbs.size()) {
+            return lhs.limbs.size() <=> rhs.limbs.size();
+        }
+        for (std::size_t i = lhs.limbs.size(); i-- > 0;) {
+            if (lhs.limbs[i] != rhs.limbs[i]) {
+                return lhs.limbs[i] <=> rhs.limbs[i];
+            }
+        }
+        return std::strong_ordering::equal;
+    }
+    friend constexpr bool operator==(const big_uint&, const big_uint&) = default;
+
+    // *this /= divisor, returning the remainder
+    constexpr std::uint32_t divide_small(std::uint32_t divisor) {
+        std::uint64_t remainder = 0;
+        for (std::size_t i = limbs.size(); i-- > 0;) {
+            const std::uint64_t current = (remainder << 32) | limbs[i];
+            limbs[i] = static_cast<std::uint32_t>(current / divisor);
+            remainder = current % divisor;
+        }
+        trim();
+        return static_cast<std::uint32_t>(remainder);
+    }
+
+    constexpr big_uint& shift_right_one() {
+        for (std::size_t i = 0; i < limbs.size(); ++i) {
+            limbs[i] = (limbs[i] >> 1) | (i + 1 < limbs.size() ? limbs[i + 1] << 31 : 0);
+        }
+        trim();
+        return *this;
+    }
+
+    // Quotient of *this / divisor when it is known to fit in 64 bits; *this becomes the remainder
+    constexpr std::uint64_t divide_small_quotient(const big_uint& divisor) {
+        std::uint64_t quotient = 0;
+        const std::size_t this_bits = bit_length();
+        const std::size_t divisor_bits = divisor.bit_length();
+        if (this_bits < divisor_bits) {
+            return 0;
+        }
+        std::size_t shift = this_bits - divisor_bits;
+        big_uint shifted = divisor;
+        shifted.shift_left(shift);
+        for (;;) {
+            if (*this >= shifted) {
+                subtract(shifted);
+                quotient |= std::uint64_t{1} << shift;
+            }
+            if (shift == 0) {
+                return quotient;
+            }
+            --shift;
+            shifted.shift_right_one();
+        }
+    }
+};
+
+// Layout of the IEEE-754 binary formats used by float and double
+template<std::floating_point T>
+struct float_traits;
+
+template<>
+struct float_traits<double> {
+    using bits_type = std::uint64_t;
+    static constexpr int significand_bits = 53;      // Including the implicit bit
+    static constexpr int min_exponent = -1074;       // Exponent of the smallest subnormal
+    static constexpr int max_exponent = 1023 - 52;   // Exponent of significands of the largest finite value
+    static constexpr int max_decimal_magnitude = 310;  // Beyond 10^this always overflows
+    static constexpr int min_decimal_magnitude = -330; // Below 10^this always rounds to zero
+    static constexpr int max_digits = 17;            // Enough significant digits to round-trip any value
+};
+
+template<>
+struct float_traits<float> {
+    using bits_type = std::uint32_t;
+    static constexpr int significand_bits = 24;
+    static constexpr int min_exponent = -149;
+    static constexpr int max_exponent = 127 - 23;
+    static constexpr int max_decimal_magnitude = 40;
+    static constexpr int min_decimal_magnitude = -50;
+    static constexpr int max_digits = 9;
+};
+
+// Assembles a T from sign, significand of at most significand_bits bits and binary exponent
+// (value = significand * 2^exponent), already rounded. Overflow yields infinity.
+template<std::floating_point T>
+constexpr T make_float(bool negative, std::uint64_t significand, int exponent) {
+    using traits = float_traits<T>;
+    using bits_type = typename traits::bits_type;
+    constexpr int explicit_bits = traits::significand_bits - 1;
+    constexpr int exponent_bias = traits::max_exponent + explicit_bits;
+    constexpr bits_type exponent_mask = (bits_type{1} << (sizeof(T) * 8 - 1 - explicit_bits)) - 1;
+    bits_type bits = 0;
+    if (significand != 0) {
+        if (significand >= (std::uint64_t{1} << explicit_bits)) {
+            const int biased = exponent + explicit_bits + exponent_bias;
+            bits = biased >= static_cast<int>(exponent_mask)
+                       ? static_cast<bits_type>(exponent_mask << explicit_bits)
+                       : static_cast<bits_type>((static_cast<bits_type>(biased) << explicit_bits) |
+                                                (significand & ((std::uint64_t{1} << explicit_bits) - 1)));
+        } else {
+            bits = static_cast<bits_type>(significand); // Subnormal: exponent is min_exponent
+        }
+    }
+    if (negative) {
+        bits |= bits_type{1} << (sizeof(T) * 8 - 1);
+    }
+    return std::bit_cast<T>(bits);
+}
+
+// Correctly rounded (round-half-to-even) conversion of digits * 10^exponent10, where digits is
+// an exact decimal significand of digit_count digits, following the same rounding as std::from_chars.
+template<std::floating_point T>
+constexpr parse_result<T> decimal_to_float(bool negative, const big_uint& digits, std::size_t digit_count,
+                                           long long exponent10) {
+    using traits = float_traits<T>;
+    constexpr int bits = traits::significand_bits;
+    parse_result<T> result;
+    if (digits.is_zero()) {
+        result.value = negative ? -T{0} : T{0};
+        return result;
+    }
+    const long long magnitude = static_cast<long long>(digit_count) + exponent10; // value < 10^magnitude
+    if (magnitude > traits::max_decimal_magnitude) {
+        result.error = parse_error::out_of_range;
+        return result;
+    }
+    if (magnitude < traits::min_decimal_magnitude) {
+        result.value = negative ? -T{0} : T{0}; // Far below half the smallest subnormal
+        return result;
+    }
+
+    big_uint numerator = digits;
+    big_uint denominator(1);
+    if (exponent10 >= 0) {
+        numerator.mul_pow10(static_cast<std::size_t>(exponent10));
+    } else {
+        denominator.mul_pow10(static_cast<std::size_t>(-exponent10));
+    }
+
+    // Pick shift so that q = floor(numerator * 2^shift / denominator) has bits + 1 bits: the
+    // significand plus one rounding bit. shift may be negative (scaling the denominator instead).
+    // The bit lengths pin q down to bits + 1 or bits + 2 bits; an extra low bit is folded into
+    // the sticky bit afterwards instead of dividing again.
+    // Subnormals have fewer significand bits: the rounding bit must not go below 2^(min_exponent - 1).
+    constexpr long long max_shift = 1 - traits::min_exponent;
+    long long shift = (bits + 1) - (static_cast<long long>(numerator.bit_length()) -
+                                    static_cast<long long>(denominator.bit_length()));
+    if (shift > max_shift) {
+        shift = max_shift;
+    }
+    if (shift >= 0) {
+        numerator.shift_left(static_cast<std::size_t>(shift));
+    } else {
+        denominator.shift_left(static_cast<std::size_t>(-shift));
+    }
+    std::uint64_t q = numerator.divide_small_quotient(denominator);
+    bool sticky = !numerator.is_zero();
+    while (q >= (std::uint64_t{1} << (bits + 1))) {
+        sticky |= (q & 1) != 0;
+        q >>= 1;
+        --shift;
+    }
+
+    std::uint64_t significand = q >> 1;
+    const bool round_bit = (q & 1) != 0;
+    int exponent = static_cast<int>(1 - shift);
+    if (round_bit && (sticky || (significand & 1) != 0)) {
+        ++significand;
+        if (significand == (std::uint64_t{1} << bits)) {
+            significand >>= 1;
+            ++exponent;
+        }
+    }
+    if (significand >= (std::uint64_t{1} << (bits - 1)) && exponent > traits::max_exponent) {
+        result.error = parse_error::out_of_range;
+        return result;
+    }
+    result.value = make_float<T>(negative, significand, exponent);
+    return result;
+}
+
+// Floating-point grammar of std::from_chars with chars_format::general: an optional '-',
+// decimal digits with an optional '.', an optional exponent ('e' or 'E', optional sign,
+// digits), or "inf", "infinity", "nan", "nan(chars)" in any case. The whole input has to be
+// consumed. Significands longer than 768 digits keep a sticky digit, as in fast_float.
+template<typename CharT>
+constexpr parse_result<double> parse_floating(const CharT* str, std::size_t n) {
+    parse_result<double> result;
+    std::size_t i = 0;
+    const bool negative = n > 0 && str[0] == CharT('-');
+    if (negative) {
+        ++i;
+    }
+    if (i == n) {
+        result.error = parse_error::empty;
+        return result;
+    }
+
+    const auto matches_word = [&](std::size_t at, const char* word) {
+        for (; *word != '\0'; ++word, ++at) {
+            if (at == n || ascii_to_lower(str[at]) != CharT(*word)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (matches_word(i, "inf")) {
+        const std::size_t end = matches_word(i, "infinity") ? i + 8 : i + 3;
+        if (end != n) {
+            result.error = parse_error::invalid_character;
+            return result;
+        }
+        result.value = negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+        return result;
+    }
+    if (matches_word(i, "nan")) {
+        std::size_t end = i + 3;
+        if (end < n && str[end] == CharT('(')) {
+            ++end;
+            while (end < n && (digit_value(str[end]) < 36 || str[end] == CharT('_'))) {
+                ++end;
+            }
+            if (end == n || str[end] != CharT(')')) {
+                result.error = parse_error::invalid_character;
+                return result;
+            }
+            ++end;
+        }
+        if (end != n) {
+            result.error = parse_error::invalid_character;
+            return result;
+        }
+        result.value = negative ? -std::numeric_limits<double>::quiet_NaN() : std::numeric_limits<double>::quiet_NaN();
+        return result;
+    }
+
+    constexpr std::size_t max_digits = 768;
+    big_uint digits;
+    std::size_t digit_count = 0;   // Significant digits kept in `digits`
+    long long exponent10 = 0;
+    bool any_digit = false;
+    bool dropped_nonzero = false;
+    bool seen_point = false;
+    for (; i < n; ++i) {
+        const CharT c = str[i];
+        if (c == CharT('.') && !seen_point) {
+            seen_point = true;
+            continue;
+        }
+        if (c < CharT('0') || c > CharT('9')) {
+            break;
+        }
+        any_digit = true;
+        const auto d = static_cast<std::uint32_t>(c - CharT('0'));
+        if (digit_count == 0 && d == 0) {
+            exponent10 -= seen_point ? 1 : 0; // Leading zeros only shift the exponent
+            continue;
+        }
+        if (digit_count < max_digits) {
+            digits.mul_add(10, d);
+            ++digit_count;
+            exponent10 -= seen_point ? 1 : 0;
+        } else {
+            dropped_nonzero |= d != 0;
+            exponent10 += seen_point ? 0 : 1;
+        }
+    }
+    if (!any_digit) {
+        result.error = parse_error::invalid_character;
+        return result;
+    }
+    if (i < n) {
+        if (str[i] != CharT('e') && str[i] != CharT('E')) {
+            result.error = parse_error::invalid_character;
+            return result;
+        }
+        ++i;
+        bool exponent_negative = false;
+        if (i < n && (str[i] == CharT('+') || str[i] == CharT('-'))) {
+            exponent_negative = str[i] == CharT('-');
+            ++i;
+        }
+        if (i == n) {
+            result.error = parse_error::invalid_character;
+            return result;
+        }
+        long long exponent = 0;
+        for (; i < n; ++i) {
+            if (str[i] < CharT('0') || str[i] > CharT('9')) {
+                result.error = parse_error::invalid_character;
+                return result;
+            }
+            if (exponent < 100'000'000) { // Saturate; anything beyond is 0 or out of range anyway
+                exponent = exponent * 10 + (str[i] - CharT('0'));
+            }
+        }
+        exponent10 += exponent_negative ? -exponent : exponent;
+    }
+    if (dropped_nonzero) {
+        // Append a sticky 1 below the kept digits so that exact halfway cases round up
+        digits.mul_add(10, 1);
+        ++digit_count;
+        --exponent10;
+    }
+    return decimal_to_float<double>(negative, digits, digit_count, exponent10);
+}
+
+} // namespace ct_detail
+
+// Parse the content of S at compile time, with the grammar of std::from_chars (see
+// ct_detail::parse_integer and ct_detail::parse_floating). Malformed or out-of-range input
+// fails a static_assert naming the problem.
+// Example: constexpr auto port = parse_uint<"8080">();            // 8080ULL
+//          constexpr auto mask = parse_uint<"ff00", 16, std::uint16_t>(); // 0xFF00
+CT_STRING_EXPORT template<ct_string S, int Base = 10, std::signed_integral T = long long>
+constexpr T parse_int() {
+    static_assert(Base >= 2 && Base <= 36, "parse_int: base must be in [2, 36]");
+    constexpr auto result = ct_detail::parse_integer<T>(S.c_str(), S.size(), Base);
+    static_assert(result.error != parse_error::empty, "parse_int: input has no digits");
+    static_assert(result.error != parse_error::invalid_character, "parse_int: input is not an integer in this base");
+    static_assert(result.error != parse_error::out_of_range, "parse_int: value does not fit the result type");
+    return result.value;
+}
+
+CT_STRING_EXPORT template<ct_string S, int Base = 10, std::unsigned_integral T = unsigned long long>
+constexpr T parse_uint() {
+    static_assert(Base >= 2 && Base <= 36, "parse_uint: base must be in [2, 36]");
+    constexpr auto result = ct_detail::parse_integer<T>(S.c_str(), S.size(), Base);
+    static_assert(result.error != parse_error::empty, "parse_uint: input has no digits");
+    static_assert(result.error != parse_error::invalid_character, "parse_uint: input is not an unsigned integer in this base");
+    static_assert(result.error != parse_error::out_of_range, "parse_uint: value does not fit the result type");
+    return result.value;
+}
+
+// Correctly rounded, like std::from_chars. Overflow to infinity is rejected; "inf" is accepted.
+// Values too small for the smallest subnormal round to zero of the input's sign.
+CT_STRING_EXPORT template<ct_string S>
+constexpr double parse_double() {
+    constexpr auto result = ct_detail::parse_floating(S.c_str(), S.size());
+    static_assert(result.error != parse_error::empty, "parse_double: input has no digits");
+    static_assert(result.error != parse_error::invalid_character, "parse_double: input is not a floating-point number");
+    static_assert(result.error != parse_error::out_of_range, "parse_double: value overflows double");
+    return result.value;
+}
+
+// Runtime counterparts built on std::from_chars. They accept exactly the grammar of the
+// compile-time parsers, require the whole input to be consumed and give the same results;
+// std::nullopt where the compile-time parser would fail, including a base outside [2, 36].
+CT_STRING_EXPORT template<std::integral T>
+    requires(!std::same_as<T, bool>)
+std::optional<T> try_parse_int(std::string_view input, int base = 10) {
+    if (base < 2 || base > 36) { // std::from_chars requires a valid base
+        return std::nullopt;
+    }
+    T value{};
+    const auto [end, ec] = std::from_chars(input.data(), input.data() + input.size(), value, base);
+    if (ec != std::errc{} || end != input.data() + input.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+CT_STRING_EXPORT inline std::optional<double> try_parse_double(std::string_view input) {
+    double value{};
+    const auto [end, ec] = std::from_chars(input.data(), input.data() + input.size(), value);
+    if (end != input.data() + input.size()) {
+        return std::nullopt;
+    }
+    if (ec == std::errc::result_out_of_range) {
+        // from_chars reports underflow to zero like overflow. The exact parser tells them
+        // apart; this only runs for inputs beyond the range of double.
+        const auto exact = ct_detail::parse_floating(input.data(), input.size());
+        if (exact.error != parse_error::none) {
+            return std::nullopt;
+        }
+        return exact.value;
+    }
+    if (ec != std::errc{}) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// --- Floating-point formatting ---
+
+// Notation used by to_ct_string for floating-point values
+//   general:    the shorter of fixed and scientific, fixed on a tie (std::to_chars without a format)
+//   fixed:      no exponent ("1500", "0.001")
+//   scientific: one digit before the point and at least two exponent digits ("1.5e+03")
+CT_STRING_EXPORT enum class float_format { general, fixed, scientific };
+
+namespace ct_detail {
+
+// value = significand * 10^exponent with the fewest significant digits that still parse back to
+// the original value, choosing the candidate closest to it (ties to even), like Ryu and
+// Dragonbox. Computed Dragon4-style: the candidates are checked against the rounding interval
+// with exact big-integer arithmetic, which is slower than those algorithms' tables but needs
+// none and only ever runs at compile time.
+struct decimal_float {
+    std::uint64_t significand = 0;
+    int exponent = 0;
+    int digit_count = 1;
+};
+
+constexpr int count_digits(std::uint64_t value) {
+    int count = 1;
+    for (; value >= 10; value /= 10) {
+        ++count;
+    }
+    return count;
+}
+
+// Finite non-negative value split into value = mantissa * 2^exponent
+struct binary_float {
+    std::uint64_t mantissa = 0;
+    int exponent = 0;
+    bool lower_gap_halved = false; // Power of two: the next lower value is only half a step away
+};
+
+template<std::floating_point T>
+constexpr binary_float decompose_float(T value) {
+    using traits = float_traits<T>;
+    using bits_type = typename traits::bits_type;
+    constexpr int explicit_bits = traits::significand_bits - 1;
+    const auto bits = std::bit_cast<bits_type>(value);
+    const auto biased = static_cast<int>(bits >> explicit_bits);
+    binary_float result;
+    result.mantissa = bits & ((bits_type{1} << explicit_bits) - 1);
+    result.exponent = traits::min_exponent;
+    if (biased != 0) {
+        result.lower_gap_halved = result.mantissa == 0 && biased > 1;
+        result.mantissa |= std::uint64_t{1} << explicit_bits;
+        result.exponent = traits::min_exponent + biased - 1;
+    }
+    return result;
+}
+
+// value = numerator / denominator exactly, for finite non-negative value
+template<std::floating_point T>
+constexpr void to_fraction(T value, big_uint& numerator, big_uint& denominator) {
+    const binary_float binary = decompose_float(value);
+    numerator = big_uint(binary.mantissa);
+    denominator = big_uint(1);
+    if (binary.exponent >= 0) {
+        numerator.shift_left(static_cast<std::size_t>(binary.exponent));
+    } else {
+        denominator.shift_left(static_cast<std::size_t>(-binary.exponent));
+    }
+}
+
+template<std::floating_point T>
+constexpr decimal_float shortest_decimal(T value) { // value finite and > 0
+    using traits = float_traits<T>;
+    const binary_float binary = decompose_float(value);
+    big_uint numerator;
+    big_uint denominator;
+    to_fraction(value, numerator, denominator);
+    // One step between adjacent values, 2^exponent, over the same denominator
+    big_uint step(1);
+    if (binary.exponent >= 0) {
+        step.shift_left(static_cast<std::size_t>(binary.exponent));
+    }
+    // Decimals exactly halfway to a neighbour parse back to the even mantissa
+    const bool inclusive = binary.mantissa % 2 == 0;
+
+    // Decimal exponent k of the leading digit: 10^k <= value < 10^(k+1)
+    int k = static_cast<int>((static_cast<long long>(numerator.bit_length()) -
+                              static_cast<long long>(denominator.bit_length())) * 30103 / 100000);
+    const auto scaled_compare = [&](int power) { // value <=> 10^power
+        big_uint n = numerator;
+        big_uint d = denominator;
+        if (power >= 0) {
+            d.mul_pow10(static_cast<std::size_t>(power));
+        } else {
+            n.mul_pow10(static_cast<std::size_t>(-power));
+        }
+        return n <=> d;
+    };
+    while (scaled_compare(k) < 0) {
+        --k;
+    }
+    while (scaled_compare(k + 1) >= 0) {
+        ++k;
+    }
+
+    decimal_float result;
+    for (int digits = 1; digits <= traits::max_digits; ++digits) {
+        // value * 10^scale = n / d, and floor of it has `digits` digits
+        const int scale = digits - 1 - k;
+        big_uint n = numerator;
+        big_uint d = denominator;
+        big_uint half_step_x4 = step; // 4 * (step / 2) * 10^scale, over d
+        half_step_x4.shift_left(1);
+        if (scale >= 0) {
+            n.mul_pow10(static_cast<std::size_t>(scale));
+            half_step_x4.mul_pow10(static_cast<std::size_t>(scale));
+        } else {
+            d.mul_pow10(static_cast<std::size_t>(-scale));
+        }
+        const std::uint64_t lower = n.divide_small_quotient(d); // n is now the remainder
+        const std::uint64_t upper = lower + 1;
+        if (n.is_zero()) {
+            result.significand = lower; // Exact
+            result.exponent = -scale;
+            break;
+        }
+        // A candidate parses back to value iff it lies within half a step of it (a quarter step
+        // below powers of two). Distances are compared in quarters to stay in integers.
+        big_uint lower_distance_x4 = n; // 4 * (value * 10^scale - lower), over d
+        lower_distance_x4.shift_left(2);
+        big_uint upper_distance_x4 = d; // 4 * (upper - value * 10^scale), over d
+        upper_distance_x4.subtract(n).shift_left(2);
+        big_uint lower_limit_x4 = half_step_x4;
+        if (binary.lower_gap_halved) {
+            lower_limit_x4.shift_right_one();
+        }
+        const auto lower_cmp = lower_distance_x4 <=> lower_limit_x4;
+        const auto upper_cmp = upper_distance_x4 <=> half_step_x4;
+        const bool lower_ok = lower != 0 && (lower_cmp < 0 || (inclusive && lower_cmp == 0));
+        const bool upper_ok = upper_cmp < 0 || (inclusive && upper_cmp == 0);
+        if (lower_ok && upper_ok) {
+            const auto closer = lower_distance_x4 <=> upper_distance_x4;
+            result.significand = (closer < 0 || (closer == 0 && lower % 2 == 0)) ? lower : upper;
+        } else if (lower_ok || upper_ok) {
+            result.significand = lower_ok ? lower : upper;
+        } else {
+            continue;
+        }
+        result.exponent = -scale;
+        break;
+    }
+    while (result.significand % 10 == 0) {
+        result.significand /= 10;
+        ++result.exponent;
+    }
+    result.digit_count = count_digits(result.significand);
+    return result;
+}
+
+// Enough for any float or double in every notation ("-0." + 323 zeros + 17 digits)
+struct float_chars {
+    std::array<char, 352> buffer{};
+    std::size_t size = 0;
+
+    constexpr void push(char c) { buffer[size++] = c; }
+};
+
+template<std::floating_point T>
+constexpr float_chars format_float(T value, float_format format) {
+    float_chars out;
+    const bool negative = std::bit_cast<typename float_traits<T>::bits_type>(value) >> (sizeof(T) * 8 - 1);
+    if (negative) {
+        out.push('-');
+    }
+    if (value != value) {
+        for (const char c : {'n', 'a', 'n'}) out.push(c);
+        return out;
+    }
+    if (value == std::numeric_limits<T>::infinity() || value == -std::numeric_limits<T>::infinity()) {
+        for (const char c : {'i', 'n', 'f'}) out.push(c);
+        return out;
+    }
+
+    decimal_float decimal;
+    if (value != T{0}) {
+        decimal = shortest_decimal(negative ? -value : value);
+    }
+    std::array<char, 20> digits{};
+    for (std::uint64_t s = decimal.significand, i = decimal.digit_count; i-- > 0; s /= 10) {
+        digits[i] = static_cast<char>('0' + s % 10);
+    }
+    const int n = decimal.digit_count;
+    const int point = n + decimal.exponent; // Digits before the decimal point in fixed notation
+
+    const auto fixed_length = [&] {
+        return point <= 0 ? 2 + (-point) + n : (decimal.exponent >= 0 ? point : n + 1);
+    };
+    const auto scientific_exponent = point - 1;
+    const auto scientific_length = [&] {
+        const int abs_exponent = scientific_exponent < 0 ? -scientific_exponent : scientific_exponent;
+        return n + (n > 1 ? 1 : 0) + 2 + (abs_exponent >= 100 ? 3 : 2);
+    };
+    if (format == float_format::general) {
+        format = fixed_length() <= scientific_length() ? float_format::fixed : float_format::scientific;
+    }
+
+    if (format == float_format::fixed) {
+        if (point > n) {
+            // An integer too large for the shortest digits alone: of the equally short
+            // representations, print the exact value, which is the closest one (as std::to_chars does)
+            big_uint numerator;
+            big_uint denominator;
+            to_fraction(negative ? -value : value, numerator, denominator);
+            while (denominator != big_uint(1)) { // Integral here: the power-of-two denominator divides exactly
+                numerator.divide_small(2);
+                denominator.divide_small(2);
+            }
+            std::array<char, 320> exact{};
+            std::size_t length = 0;
+            while (!numerator.is_zero()) {
+                exact[length++] = static_cast<char>('0' + numerator.divide_small(10));
+            }
+            while (length > 0) {
+                out.push(exact[--length]);
+            }
+        } else if (point <= 0) {
+            out.push('0');
+            out.push('.');
+            for (int i = 0; i < -point; ++i) out.push('0');
+            for (int i = 0; i < n; ++i) out.push(digits[i]);
+        } else {
+            for (int i = 0; i < point; ++i) out.push(i < n ? digits[i] : '0');
+            if (point < n) {
+                out.push('.');
+                for (int i = point; i < n; ++i) out.push(digits[i]);
+            }
+        }
+    } else {
+        out.push(digits[0]);
+        if (n > 1) {
+            out.push('.');
+            for (int i = 1; i < n; ++i) out.push(digits[i]);
+        }
+        out.push('e');
+        out.push(scientific_exponent < 0 ? '-' : '+');
+        const int abs_exponent = scientific_exponent < 0 ? -scientific_exponent : scientific_exponent;
+        if (abs_exponent >= 100) {
+            out.push(static_cast<char>('0' + abs_exponent / 100));
+        }
+        out.push(static_cast<char>('0' + abs_exponent / 10 % 10));
+        out.push(static_cast<char>('0' + abs_exponent % 10));
+    }
+    return out;
+}
+
+template<auto V, float_format Format>
+inline constexpr float_chars formatted_float = format_float(V, Format);
+
+} // namespace ct_detail
+
+// Shortest round-trip text of a float or double constant, at compile time (std::to_chars is
+// not constexpr for floating point in C++20). Parsing the result gives back exactly V.
+// Example: constexpr auto label = ct_string("threshold=") + to_ct_string<0.3>(); // "threshold=0.3"
+//          to_ct_string<1500.0, float_format::scientific>()                      // "1.5e+03"
+CT_STRING_EXPORT template<auto V, float_format Format = float_format::general>
+    requires std::is_same_v<decltype(V), double> || std::is_same_v<decltype(V), float>
+constexpr auto to_ct_string() {
+    constexpr const auto& chars = ct_detail::formatted_float<V, Format>;
+    ct_string<chars.size> result{};
+    std::copy(chars.buffer.begin(), chars.buffer.begin() + chars.size, result.data.begin());
+    return result;
+}
+
+// --- Binary-to-text encodings ---
+
+// Base64 alphabets of RFC 4648: standard ("+/", padded with '=') and URL-safe ("-_", unpadded)
+CT_STRING_EXPORT enum class base64_variant { standard, url };
+
+namespace ct_detail {
+
+inline constexpr char base64_standard_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+inline constexpr char base64_url_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// Value of a base64 character, or 64 if it is not part of the alphabet
+template<typename CharT>
+constexpr unsigned base64_value(CharT c, base64_variant variant) {
+    if (c >= CharT('A') && c <= CharT('Z')) return static_cast<unsigned>(c - CharT('A'));
+    if (c >= CharT('a') && c <= CharT('z')) return static_cast<unsigned>(c - CharT('a')) + 26;
+    if (c >= CharT('0') && c <= CharT('9')) return static_cast<unsigned>(c - CharT('0')) + 52;
+    if (c == CharT(variant == base64_variant::url ? '-' : '+')) return 62;
+    if (c == CharT(variant == base64_variant::url ? '_' : '/')) return 63;
+    return 64;
+}
+
+// Result of a compile-time decode: the bytes plus the first problem found
+template<std::size_t N>
+struct decode_result {
+    std::array<std::byte, N> bytes{};
+    parse_error error = parse_error::none;
+};
+
+template<std::size_t N, typename CharT>
+constexpr decode_result<N> hex_decode(const CharT* str, std::size_t n) {
+    decode_result<N> result;
+    if (n != N * 2) {
+        result.error = parse_error::out_of_range;
+        return result;
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        const unsigned high = digit_value(str[2 * i]);
+        const unsigned low = digit_value(str[2 * i + 1]);
+        if (high >= 16 || low >= 16) {
+            result.error = parse_error::invalid_character;
+            return result;
+        }
+        result.bytes[i] = static_cast<std::byte>(high << 4 | low);
+    }
+    return result;
+}
+
+// Number of characters after stripping up to two trailing '=' of a padded standard encoding
+template<typename CharT>
+constexpr std::size_t base64_unpadded_length(const CharT* str, std::size_t n, base64_variant variant) {
+    if (variant == base64_variant::standard && n % 4 == 0) {
+        for (int k = 0; k < 2 && n > 0 && str[n - 1] == CharT('='); ++k) {
+            --n;
+        }
+    }
+    return n;
+}
+
+template<std::size_t N, typename CharT>
+constexpr decode_result<N> base64_decode(const CharT* str, std::size_t n, base64_variant variant) {
+    decode_result<N> result;
+    const std::size_t length = base64_unpadded_length(str, n, variant);
+    if (variant == base64_variant::standard && n % 4 != 0) {
+        result.error = parse_error::out_of_range; // Standard base64 has to be padded
+        return result;
+    }
+    std::uint32_t accumulator = 0;
+    int bits = 0;
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < length; ++i) {
+        const unsigned value = base64_value(str[i], variant);
+        if (value >= 64) {
+            result.error = parse_error::invalid_character;
+            return result;
+        }
+        accumulator = (accumulator << 6) | value;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            result.bytes[out++] = static_cast<std::byte>(accumulator >> bits);
+            accumulator &= (1u << bits) - 1;
+        }
+    }
+    // Leftover bits must be zero (canonical encoding), and a single leftover character is impossible
+    if (length % 4 == 1 || accumulator != 0) {
+        result.error = parse_error::invalid_character;
+    }
+    return result;
+}
+
+// Canonical "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx", optionally enclosed in braces
+template<typename CharT>
+constexpr decode_result<16> parse_uuid(const CharT* str, std::size_t n) {
+    decode_result<16> result;
+    if (n == 38 && str[0] == CharT('{') && str[37] == CharT('}')) {
+        ++str;
+        n -= 2;
+    }
+    if (n != 36) {
+        result.error = parse_error::out_of_range;
+        return result;
+    }
+    std::array<CharT, 32> digits{};
+    std::size_t d = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const bool dash_position = i == 8 || i == 13 || i == 18 || i == 23;
+        if (dash_position != (str[i] == CharT('-'))) {
+            result.error = parse_error::invalid_character;
+            return result;
+        }
+        if (!dash_position) {
+            digits[d++] = str[i];
+        }
+    }
+    return hex_decode<16>(digits.data(), digits.size());
+}
+
+template<ct_string S>
+constexpr auto hex_encode_ct() {
+    constexpr char digits[] = "0123456789abcdef";
+    ct_string<S.size() * 2> result{};
+    for (std::size_t i = 0; i < S.size(); ++i) {
+        const auto byte = static_cast<unsigned char>(S[i]);
+        result.data[2 * i] = digits[byte >> 4];
+        result.data[2 * i + 1] = digits[byte & 0x0F];
+    }
+    return result;
+}
+
+template<ct_string S, base64_variant Variant>
+constexpr auto base64_encode_ct() {
+    constexpr std::size_t full = S.size() / 3;
+    constexpr std::size_t rest = S.size() % 3;
+    constexpr std::size_t length = Variant == base64_variant::standard
+                                       ? (S.size() + 2) / 3 * 4
+                                       : full * 4 + (rest == 0 ? 0 : rest + 1);
+    const char* alphabet = Variant == base64_variant::standard ? base64_standard_chars
+                                                               : base64_url_chars;
+    ct_string<length> result{};
+    std::size_t o = 0;
+    for (std::size_t i = 0; i < S.size(); i += 3) {
+        const std::size_t remaining = S.size() - i;
+        const auto byte_at = [&](std::size_t k) {
+            return k < remaining ? static_cast<std::uint32_t>(static_cast<unsigned char>(S[i + k])) : 0u;
+        };
+        const std::uint32_t group = byte_at(0) << 16 | byte_at(1) << 8 | byte_at(2);
+        const std::size_t chars = remaining >= 3 ? 4 : remaining + 1;
+        for (std::size_t k = 0; k < chars; ++k) {
+            result.data[o++] = alphabet[(group >> (18 - 6 * k)) & 0x3F];
+        }
+    }
+    while (o < length) {
+        result.data[o++] = '=';
+    }
+    return result;
+}
+
+// Evaluated once per input, so repeated encodes of a constant share one result
+template<ct_string S>
+inline constexpr auto hex_encoded_v = hex_encode_ct<S>();
+
+template<ct_string S, base64_variant Variant>
+inline constexpr auto base64_encoded_v = base64_encode_ct<S, Variant>();
+
+} // namespace ct_detail
+
+// Decode text constants into raw bytes at compile time. Malformed input fails a static_assert.
+// Example: constexpr auto magic = hex_decode<"89504e470d0a1a0a">(); // std::array<std::byte, 8>
+
+// Hex digits in either case, two per byte, no separators or prefix
+CT_STRING_EXPORT template<ct_string S>
+constexpr std::array<std::byte, S.size() / 2> hex_decode() {
+    constexpr auto result = ct_detail::hex_decode<S.size() / 2>(S.c_str(), S.size());
+    static_assert(result.error != parse_error::out_of_range, "hex_decode: input must have an even number of digits");
+    static_assert(result.error != parse_error::invalid_character, "hex_decode: input contains a non-hex character");
+    return result.bytes;
+}
+
+// Lowercase hex digits of the bytes of a byte string
+CT_STRING_EXPORT template<ct_string S>
+    requires (sizeof(typename decltype(S)::value_type) == 1)
+constexpr auto hex_encode() {
+    return ct_detail::hex_encoded_v<S>;
+}
+
+// Base64 of the bytes of a byte string; padded with '=' for the standard variant
+CT_STRING_EXPORT template<ct_string S, base64_variant Variant = base64_variant::standard>
+    requires (sizeof(typename decltype(S)::value_type) == 1)
+constexpr auto base64_encode() {
+    return ct_detail::base64_encoded_v<S, Variant>;
+}
+
+CT_STRING_EXPORT template<ct_string S, base64_variant Variant = base64_variant::standard>
+constexpr auto base64_decode() {
+    constexpr std::size_t length = ct_detail::base64_unpadded_length(S.c_str(), S.size(), Variant);
+    constexpr auto result = ct_detail::base64_decode<length * 6 / 8>(S.c_str(), S.size(), Variant);
+    static_assert(result.error != parse_error::out_of_range, "base64_decode: standard base64 must be padded to a multiple of 4");
+    static_assert(result.error != parse_error::invalid_character, "base64_decode: input is not canonical base64");
+    return result.bytes;
+}
+
+// The 16 bytes of a UUID in network (big-endian) order, as written in its canonical text form
+// Example: constexpr auto id = parse_uuid<"123e4567-e89b-12d3-a456-426614174000">();
+CT_STRING_EXPORT template<ct_string S>
+constexpr std::array<std::byte, 16> parse_uuid() {
+    constexpr auto result = ct_detail::parse_uuid(S.c_str(), S.size());
+    static_assert(result.error != parse_error::out_of_range, "parse_uuid: expected 36 characters, or 38 with braces");
+    static_assert(result.error != parse_error::invalid_character, "parse_uuid: expected xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx with hex digits");
+    return result.bytes;
+}
@@ -0,0 +1,23 @@
+module;
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <bit>         // For std::bit_cast, std::countl_zero
+#include <charconv>    // For std::from_chars in the runtime parsers
+#include <concepts>
+#include <limits>      // For std::numeric_limits
+#include <optional>    // For the runtime parsers' results
+#include <string_view>
+#include <utility>     // For std::pair
+#include <vector>      // For the big integers of exact float conversion
+
+#define CT_STRING_MODULE_INTERFACE
+
+export module ct_string.format;
+
+export import ct_string.core;
+
+// ct_string.format.hpp with its public declarations exported
+#include "ct_string.format.hpp"
@@ -0,0 +1,472 @@
+#pragma once
+
+// CRC-32/CRC-32C, MD5 and SHA-256 at compile time and at runtime, and schema fingerprints
+
+#include "ct_string.config.hpp"
+
+#ifndef CT_STRING_MODULE_INTERFACE
+#include "ct_string.core.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>   // For std::sort in schema canonicalization
+#include <bit>         // For std::rotl, std::rotr
+#include <string_view>
+#include <utility>     // For std::pair
+#endif
+
+// --- Checksums and digests ---
+
+// Digest results are raw bytes in the order the algorithm's specification writes them
+CT_STRING_EXPORT using md5_digest = std::array<std::byte, 16>;
+CT_STRING_EXPORT using sha256_digest = std::array<std::byte, 32>;
+
+namespace ct_detail {
+
+// Byte-sized code units (char, char8_t) and the unsigned char of internal buffers
+template<typename CharT>
+concept byte_char = sizeof(CharT) == 1 && (ct_char<CharT> || std::same_as<CharT, unsigned char>);
+
+// The loads cast inline rather than through a helper: GCC memoizes every constexpr call with
+// constant arguments, and a call per input byte kept an entry per byte alive until the end of
+// the translation unit
+template<byte_char CharT>
+constexpr std::uint32_t load_u32_le(const CharT* p) {
+    using byte = unsigned char;
+    return std::uint32_t{byte(p[0])} | std::uint32_t{byte(p[1])} << 8 | std::uint32_t{byte(p[2])} << 16 |
+           std::uint32_t{byte(p[3])} << 24;
+}
+
+template<byte_char CharT>
+constexpr std::uint32_t load_u32_be(const CharT* p) {
+    using byte = unsigned char;
+    return std::uint32_t{byte(p[0])} << 24 | std::uint32_t{byte(p[1])} << 16 | std::uint32_t{byte(p[2])} << 8 |
+           std::uint32_t{byte(p[3])};
+}
+
+// Slicing-by-8 tables for a reflected CRC-32 polynomial: table[k][b] is the CRC of byte b
+// followed by k zero bytes, so eight input bytes are folded with eight independent lookups
+template<std::uint32_t Poly>
+constexpr std::array<std::array<std::uint32_t, 256>, 8> make_crc32_tables() {
+    std::array<std::array<std::uint32_t, 256>, 8> tables{};
+    for (std::uint32_t b = 0; b < 256; ++b) {
+        std::uint32_t crc = b;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (Poly & (0u - (crc & 1)));
+        }
+        tables[0][b] = crc;
+    }
+    for (std::size_t k = 1; k < 8; ++k) {
+        for (std::size_t b = 0; b < 256; ++b) {
+            tables[k][b] = (tables[k - 1][b] >> 8) ^ tables[0][tables[k - 1][b] & 0xFF];
+        }
+    }
+    return tables;
+}
+
+template<std::uint32_t Poly>
+inline constexpr auto crc32_tables = make_crc32_tables<Poly>();
+
+inline constexpr std::uint32_t crc32_poly = 0xEDB88320;  // ISO-HDLC (zlib, PNG, Ethernet)
+inline constexpr std::uint32_t crc32c_poly = 0x82F63B78; // Castagnoli (iSCSI, ext4, SSE4.2 crc32)
+
+// Continues `crc` (the value returned for the preceding data, 0 to start) over n bytes
+template<std::uint32_t Poly, byte_char CharT>
+constexpr std::uint32_t crc32_update(std::uint32_t crc, const CharT* p, std::size_t n) {
+    // Built-in subscripts: std::array::operator[] is a call each time during constant evaluation
+    const std::uint32_t* t[8];
+    for (std::size_t k = 0; k < 8; ++k) {
+        t[k] = crc32_tables<Poly>[k].data();
+    }
+    crc = ~crc;
+    if (std::is_constant_evaluated()) {
+        // One lookup per byte and no calls: slicing-by-8 only pays off in machine code, and
+        // during constant evaluation its loads cost more than the lookups they save
+        for (std::size_t block = 0; block < n; block += constexpr_block) {
+            const std::size_t end = block_end(block, n);
+            for (std::size_t i = block; i < end; ++i) {
+                crc = (crc >> 8) ^ t[0][(crc ^ static_cast<unsigned char>(p[i])) & 0xFF];
+            }
+        }
+        return ~crc;
+    }
+    for (; n >= 8; p += 8, n -= 8) {
+        const std::uint32_t low = load_u32_le(p) ^ crc;
+        const std::uint32_t high = load_u32_le(p + 4);
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+              t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+    }
+    for (; n > 0; ++p, --n) {
+        crc = (crc >> 8) ^ t[0][(crc ^ static_cast<unsigned char>(*p)) & 0xFF];
+    }
+    return ~crc;
+}
+
+// Shared block buffering of the Merkle-Damgard hashes; Derived supplies compress(const unsigned char*)
+template<typename Derived>
+class block_hasher {
+public:
+    template<byte_char CharT>
+    constexpr void update_bytes(const CharT* p, std::size_t n) {
+        total_bytes_ += n;
+        if (buffered_ > 0) {
+            const std::size_t take = std::min(n, std::size_t{64} - buffered_);
+            append(p, take);
+            p += take;
+            n -= take;
+            if (buffered_ < 64) return;
+            static_cast<Derived&>(*this).compress(buffer_.data());
+            buffered_ = 0;
+        }
+        while (n >= 64) {
+            for (const CharT* end = p + std::min(n / 64, constexpr_block) * 64; p != end; p += 64, n -= 64) {
+                static_cast<Derived&>(*this).compress(p);
+            }
+        }
+        append(p, n);
+    }
+
+protected:
+    // Appends 0x80, zero padding and the bit length (big- or little-endian) and compresses the rest
+    constexpr void pad(bool big_endian_length) {
+        const std::uint64_t bit_length = total_bytes_ * 8;
+        buffer_[buffered_++] = 0x80;
+        if (buffered_ > 56) {
+            std::fill(buffer_.begin() + buffered_, buffer_.end(), 0);
+            static_cast<Derived&>(*this).compress(buffer_.data());
+            buffered_ = 0;
+        }
+        std::fill(buffer_.begin() + buffered_, buffer_.begin() + 56, 0);
+        for (int i = 0; i < 8; ++i) {
+            const int shift = big_endian_length ? 56 - 8 * i : 8 * i;
+            buffer_[56 + i] = static_cast<unsigned char>(bit_length >> shift);
+        }
+        static_cast<Derived&>(*this).compress(buffer_.data());
+        buffered_ = 0;
+    }
+
+private:
+    template<byte_char CharT>
+    constexpr void append(const CharT* p, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            buffer_[buffered_ + i] = static_cast<unsigned char>(p[i]);
+        }
+        buffered_ += n;
+    }
+
+    std::array<unsigned char, 64> buffer_{};
+    std::size_t buffered_ = 0;
+    std::uint64_t total_bytes_ = 0;
+};
+
+// Round constants of MD5 (RFC 1321) and SHA-256 (FIPS 180-4)
+inline constexpr std::uint32_t md5_k[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+inline constexpr int md5_shifts[16] = {7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21};
+
+inline constexpr std::uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+} // namespace ct_detail
+
+// CRC-32 (zlib/PNG polynomial) and CRC-32C (Castagnoli) of a byte string. Pass the previous
+// result as `crc` to continue a checksum over further data. Example: crc32("123456789") == 0xCBF43926
+CT_STRING_EXPORT constexpr std::uint32_t crc32(std::string_view data, std::uint32_t crc = 0) {
+    return ct_detail::crc32_update<ct_detail::crc32_poly>(crc, data.data(), data.size());
+}
+
+CT_STRING_EXPORT constexpr std::uint32_t crc32c(std::string_view data, std::uint32_t crc = 0) {
+    return ct_detail::crc32_update<ct_detail::crc32c_poly>(crc, data.data(), data.size());
+}
+
+CT_STRING_EXPORT constexpr std::uint32_t crc32(std::u8string_view data, std::uint32_t crc = 0) {
+    return ct_detail::crc32_update<ct_detail::crc32_poly>(crc, data.data(), data.size());
+}
+
+CT_STRING_EXPORT constexpr std::uint32_t crc32c(std::u8string_view data, std::uint32_t crc = 0) {
+    return ct_detail::crc32_update<ct_detail::crc32c_poly>(crc, data.data(), data.size());
+}
+
+// Incremental MD5 (RFC 1321). Use for checksums and content IDs, not for security.
+CT_STRING_EXPORT class md5_hasher : private ct_detail::block_hasher<md5_hasher> {
+public:
+    constexpr md5_hasher& update(std::string_view data) {
+        update_bytes(data.data(), data.size());
+        return *this;
+    }
+
+    constexpr md5_hasher& update(std::u8string_view data) {
+        update_bytes(data.data(), data.size());
+        return *this;
+    }
+
+    // Pads the message and returns the digest; the hasher must not be updated afterwards
+    constexpr md5_digest finish() {
+        pad(false);
+        md5_digest digest{};
+        for (std::size_t i = 0; i < 16; ++i) {
+            digest[i] = static_cast<std::byte>(state_[i / 4] >> (8 * (i % 4)));
+        }
+        return digest;
+    }
+
+private:
+    friend ct_detail::block_hasher<md5_hasher>;
+
+    template<ct_detail::byte_char CharT>
+    constexpr void compress(const CharT* block) {
+        std::uint32_t m[16];
+        for (std::size_t i = 0; i < 16; ++i) {
+            m[i] = ct_detail::load_u32_le(block + 4 * i);
+        }
+        std::uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+        for (std::size_t i = 0; i < 64; ++i) {
+            std::uint32_t f;
+            std::size_t g;
+            if (i < 16) {
+                f = (b & c) | (~b & d);
+                g = i;
+            } else if (i < 32) {
+                f = (d & b) | (~d & c);
+                g = (5 * i + 1) % 16;
+            } else if (i < 48) {
+                f = b ^ c ^ d;
+                g = (3 * i + 5) % 16;
+            } else {
+                f = c ^ (b | ~d);
+                g = (7 * i) % 16;
+            }
+            const std::uint32_t rotated = std::rotl(a + f + ct_detail::md5_k[i] + m[g], ct_detail::md5_shifts[i / 16 * 4 + i % 4]);
+            a = d;
+            d = c;
+            c = b;
+            b += rotated;
+        }
+        state_[0] += a;
+        state_[1] += b;
+        state_[2] += c;
+        state_[3] += d;
+    }
+
+    std::array<std::uint32_t, 4> state_ = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+};
+
+// Incremental SHA-256 (FIPS 180-4)
+CT_STRING_EXPORT class sha256_hasher : private ct_detail::block_hasher<sha256_hasher> {
+public:
+    constexpr sha256_hasher& update(std::string_view data) {
+        update_bytes(data.data(), data.size());
+        return *this;
+    }
+
+    constexpr sha256_hasher& update(std::u8string_view data) {
+        update_bytes(data.data(), data.size());
+        return *this;
+    }
+
+    // Pads the message and returns the digest; the hasher must not be updated afterwards
+    constexpr sha256_digest finish() {
+        pad(true);
+        sha256_digest digest{};
+        for (std::size_t i = 0; i < 32; ++i) {
+            digest[i] = static_cast<std::byte>(state_[i / 4] >> (24 - 8 * (i % 4)));
+        }
+        return digest;
+    }
+
+private:
+    friend ct_detail::block_hasher<sha256_hasher>;
+
+    template<ct_detail::byte_char CharT>
+    constexpr void compress(const CharT* block) {
+        // Scalar working variables and built-in arrays: during constant evaluation every
+        // std::array subscript is a call, which made compression about five times slower
+        std::uint32_t w[64];
+        for (std::size_t i = 0; i < 16; ++i) {
+            w[i] = ct_detail::load_u32_be(block + 4 * i);
+        }
+        for (std::size_t i = 16; i < 64; ++i) {
+            const std::uint32_t s0 = std::rotr(w[i - 15], 7) ^ std::rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const std::uint32_t s1 = std::rotr(w[i - 2], 17) ^ std::rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        std::uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+        std::uint32_t e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+        for (std::size_t i = 0; i < 64; ++i) {
+            const std::uint32_t s1 = std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25);
+            const std::uint32_t choose = (e & f) ^ (~e & g);
+            const std::uint32_t t1 = h + s1 + choose + ct_detail::sha256_k[i] + w[i];
+            const std::uint32_t s0 = std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22);
+            const std::uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + s0 + majority;
+        }
+        state_[0] += a;
+        state_[1] += b;
+        state_[2] += c;
+        state_[3] += d;
+        state_[4] += e;
+        state_[5] += f;
+        state_[6] += g;
+        state_[7] += h;
+    }
+
+    std::array<std::uint32_t, 8> state_ = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                           0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+};
+
+// One-shot digests of a byte string, usable in constant expressions and at runtime
+CT_STRING_EXPORT constexpr md5_digest md5(std::string_view data) {
+    return md5_hasher{}.update(data).finish();
+}
+
+CT_STRING_EXPORT constexpr sha256_digest sha256(std::string_view data) {
+    return sha256_hasher{}.update(data).finish();
+}
+
+CT_STRING_EXPORT constexpr md5_digest md5(std::u8string_view data) {
+    return md5_hasher{}.update(data).finish();
+}
+
+CT_STRING_EXPORT constexpr sha256_digest sha256(std::u8string_view data) {
+    return sha256_hasher{}.update(data).finish();
+}
+
+// Digests of a ct_string constant, computed once per string during compilation.
+// Example: constexpr auto asset_id = sha256_v<"textures/stone.png">;
+CT_STRING_EXPORT template<ct_string S>
+    requires ct_detail::byte_char<typename decltype(S)::value_type>
+inline constexpr std::uint32_t crc32_v = crc32(static_cast<typename decltype(S)::view_type>(S));
+
+CT_STRING_EXPORT template<ct_string S>
+    requires ct_detail::byte_char<typename decltype(S)::value_type>
+inline constexpr std::uint32_t crc32c_v = crc32c(static_cast<typename decltype(S)::view_type>(S));
+
+CT_STRING_EXPORT template<ct_string S>
+    requires ct_detail::byte_char<typename decltype(S)::value_type>
+inline constexpr md5_digest md5_v = md5(static_cast<typename decltype(S)::view_type>(S));
+
+CT_STRING_EXPORT template<ct_string S>
+    requires ct_detail::byte_char<typename decltype(S)::value_type>
+inline constexpr sha256_digest sha256_v = sha256(static_cast<typename decltype(S)::view_type>(S));
+
+// --- Schema fingerprints ---
+
+// Fingerprint of a canonical schema text: the first eight bytes of its SHA-256, big-endian.
+// Tools that only have the text (e.g. schema registries) compute the same value at runtime.
+CT_STRING_EXPORT constexpr std::uint64_t schema_fingerprint(std::string_view canonical_text) {
+    const sha256_digest digest = sha256(canonical_text);
+    std::uint64_t fingerprint = 0;
+    for (std::size_t i = 0; i < 8; ++i) {
+        fingerprint = fingerprint << 8 | static_cast<std::uint8_t>(digest[i]);
+    }
+    return fingerprint;
+}
+
+namespace ct_detail {
+
+// Message and field names: [A-Za-z_][A-Za-z0-9_]*
+constexpr bool is_schema_identifier(std::string_view name) {
+    if (name.empty() || (name[0] >= '0' && name[0] <= '9')) return false;
+    return std::all_of(name.begin(), name.end(), [](char c) {
+        return is_ascii_alpha(c) || (c >= '0' && c <= '9') || c == '_';
+    });
+}
+
+// Type names are free-form (e.g. "u32", "list<string>", "Address") but must not contain
+// the separators of the canonical text or whitespace, which would make it ambiguous
+constexpr bool is_schema_type(std::string_view type) {
+    if (type.empty()) return false;
+    return std::none_of(type.begin(), type.end(), [](char c) {
+        return c <= ' ' || c == ';' || c == ':' || c == '{' || c == '}' || c == 0x7F;
+    });
+}
+
+template<std::size_t N>
+constexpr bool has_duplicates(std::array<std::string_view, N> names) {
+    std::sort(names.begin(), names.end());
+    return std::adjacent_find(names.begin(), names.end()) != names.end();
+}
+
+} // namespace ct_detail
+
+// Describe a wire protocol as types whose canonical text and 64-bit fingerprint are computed
+// during compilation, so a handshake compares one integer instead of exchanging the schema:
+//   using login = schema_message<"Login", schema_field<"user", "string">, schema_field<"id", "u64">>;
+//   using chat = schema<"chat", login, schema_message<"Say", schema_field<"text", "string">>>;
+//   send(chat::fingerprint);
+CT_STRING_EXPORT template<ct_string Name, ct_string Type>
+struct schema_field {
+    static_assert(std::same_as<typename decltype(Name)::value_type, char> &&
+                  std::same_as<typename decltype(Type)::value_type, char>, "schema_field: names must be char strings");
+    static_assert(ct_detail::is_schema_identifier(Name), "schema_field: field name must be an identifier");
+    static_assert(ct_detail::is_schema_type(Type), "schema_field: type must be non-empty without whitespace or ;:{}");
+
+    static constexpr auto name = Name;
+    static constexpr auto type = Type;
+    static constexpr auto canonical_text = Name + ct_string(":") + Type + ct_string(";");
+};
+
+// Fields keep their declaration order, which is part of the wire format
+CT_STRING_EXPORT template<ct_string Name, typename... Fields>
+struct schema_message {
+    static_assert(std::same_as<typename decltype(Name)::value_type, char>, "schema_message: name must be a char string");
+    static_assert(ct_detail::is_schema_identifier(Name), "schema_message: message name must be an identifier");
+    static_assert(!ct_detail::has_duplicates(std::array<std::string_view, sizeof...(Fields)>{Fields::name...}),
+                  "schema_message: duplicate field name");
+
+    static constexpr auto name = Name;
+    static constexpr auto canonical_text =
+        ct_string("message ") + Name + ct_string("{") + (ct_string("") + ... + Fields::canonical_text) + ct_string("}");
+};
+
+// Messages are canonically ordered by name, so declaration order does not change the fingerprint
+CT_STRING_EXPORT template<ct_string Name, typename... Messages>
+struct schema {
+private:
+    static constexpr auto header = ct_string("schema ") + Name + ct_string(";");
+    static constexpr std::size_t text_size = header.size() + (std::size_t{0} + ... + Messages::canonical_text.size());
+
+    static constexpr ct_string<text_size> build_text() {
+        std::array<std::pair<std::string_view, std::string_view>, sizeof...(Messages)> messages = {
+            std::pair<std::string_view, std::string_view>{Messages::name, Messages::canonical_text}...};
+        std::sort(messages.begin(), messages.end());
+        ct_string<text_size> text{};
+        auto out = std::copy(header.begin(), header.end(), text.data.begin());
+        for (const auto& message : messages) {
+            out = std::copy(message.second.begin(), message.second.end(), out);
+        }
+        return text;
+    }
+
+public:
+    static_assert(std::same_as<typename decltype(Name)::value_type, char>, "schema: name must be a char string");
+    static_assert(ct_detail::is_schema_identifier(Name), "schema: name must be an identifier");
+    static_assert(!ct_detail::has_duplicates(std::array<std::string_view, sizeof...(Messages)>{Messages::name...}),
+                  "schema: duplicate message name");
+
+    static constexpr auto name = Name;
+    // e.g. "schema chat;message Login{user:string;id:u64;}message Say{text:string;}"
+    static constexpr ct_string<text_size> canonical_text = build_text();
+    static constexpr std::uint64_t fingerprint = schema_fingerprint(canonical_text);
+};
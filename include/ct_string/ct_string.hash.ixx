@@ -0,0 +1,18 @@
+module;
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>   // For std::sort in schema canonicalization
+#include <bit>         // For std::rotl, std::rotr
+#include <string_view>
+#include <utility>     // For std::pair
+
+#define CT_STRING_MODULE_INTERFACE
+
+export module ct_string.hash;
+
+export import ct_string.core;
+
+// ct_string.hash.hpp with its public declarations exported
+#include "ct_string.hash.hpp"
@@ -0,0 +1,15 @@
+#pragma once
+
+// The whole library as headers, for compilers or builds without C++20 modules. Each
+// ct_string.<feature>.hpp can also be included on its own; see ct_string.ixx for what they
+// contain. ct_string.log.hpp and ct_string.metrics.hpp (threads), ct_string.io.hpp and
+// ct_string.http.hpp (POSIX) and ct_string.uring.hpp (Linux) are not part of it and are
+// included separately. Do not mix these includes with `import ct_string;` in one translation
+// unit.
+
+#include "ct_string.core.hpp"
+#include "ct_string.ascii.hpp"
+#include "ct_string.unicode.hpp"
+#include "ct_string.format.hpp"
+#include "ct_string.hash.hpp"
+#include "ct_string.source.hpp"
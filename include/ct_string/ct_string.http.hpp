@@ -0,0 +1,211 @@
+#pragma once
+
+// HTTP/1.1 response preambles assembled at compile time. A status line and any number of fixed
+// header lines become one contiguous ct_string constant; write_http_response() sends it, the
+// per-response header fields, the blank line and the body with a single writev() call, so the
+// constant part is never copied or rebuilt at runtime.
+
+#include "ct_string.config.hpp"
+
+#ifndef CT_STRING_MODULE_INTERFACE
+#include "ct_string.core.hpp"
+#include "ct_string.io.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#endif
+
+// --- Preamble pieces ---
+
+namespace ct_detail {
+
+// The reason phrases of RFC 9110 for the common status codes, or "" for others
+constexpr std::string_view http_reason(unsigned code) {
+    switch (code) {
+        case 100: return "Continue";
+        case 101: return "Switching Protocols";
+        case 200: return "OK";
+        case 201: return "Created";
+        case 202: return "Accepted";
+        case 204: return "No Content";
+        case 206: return "Partial Content";
+        case 301: return "Moved Permanently";
+        case 302: return "Found";
+        case 303: return "See Other";
+        case 304: return "Not Modified";
+        case 307: return "Temporary Redirect";
+        case 308: return "Permanent Redirect";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 406: return "Not Acceptable";
+        case 408: return "Request Timeout";
+        case 409: return "Conflict";
+        case 410: return "Gone";
+        case 411: return "Length Required";
+        case 412: return "Precondition Failed";
+        case 413: return "Content Too Large";
+        case 414: return "URI Too Long";
+        case 415: return "Unsupported Media Type";
+        case 416: return "Range Not Satisfiable";
+        case 417: return "Expectation Failed";
+        case 421: return "Misdirected Request";
+        case 422: return "Unprocessable Content";
+        case 426: return "Upgrade Required";
+        case 428: return "Precondition Required";
+        case 429: return "Too Many Requests";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 502: return "Bad Gateway";
+        case 503: return "Service Unavailable";
+        case 504: return "Gateway Timeout";
+        case 505: return "HTTP Version Not Supported";
+        default: return "";
+    }
+}
+
+// tchar of RFC 9110: header names are one or more of these
+constexpr bool is_http_token(std::string_view text) {
+    if (text.empty()) {
+        return false;
+    }
+    for (const char c : text) {
+        const bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                           std::string_view("!#$%&'*+-.^_`|~").find(c) != std::string_view::npos;
+        if (!valid) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Field values may hold anything but control characters other than horizontal tab
+constexpr bool is_http_field_value(std::string_view text) {
+    for (const char c : text) {
+        const auto unit = static_cast<unsigned char>(c);
+        if ((unit < 0x20 && c != '\t') || unit == 0x7F) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The decimal digits of V as a ct_string
+template<std::size_t V>
+constexpr auto decimal_text() {
+    constexpr std::size_t digits = [] {
+        std::size_t n = 1;
+        for (std::size_t rest = V / 10; rest != 0; rest /= 10) {
+            ++n;
+        }
+        return n;
+    }();
+    ct_string<digits> text{};
+    std::size_t rest = V;
+    for (std::size_t i = digits; i-- > 0; rest /= 10) {
+        text.data[i] = static_cast<char>('0' + rest % 10);
+    }
+    return text;
+}
+
+} // namespace ct_detail
+
+// The status line, e.g. http_status<404>::text == "HTTP/1.1 404 Not Found\r\n". The reason
+// phrase is looked up for common codes; give it explicitly for the others.
+CT_STRING_EXPORT template<unsigned Code, ct_string Reason = "">
+struct http_status {
+    static_assert(Code >= 100 && Code <= 999, "http_status: the status code must have three digits");
+    static_assert(std::is_same_v<typename decltype(Reason)::value_type, char>, "http_status: the reason must be a char string");
+    static_assert(Reason.size() != 0 || !ct_detail::http_reason(Code).empty(),
+                  "http_status: no standard reason phrase for this code; pass one as the second argument");
+    static_assert(ct_detail::is_http_field_value(Reason), "http_status: the reason must not contain control characters");
+
+    static constexpr unsigned code = Code;
+    static constexpr auto reason = [] {
+        if constexpr (Reason.size() != 0) {
+            return Reason;
+        } else {
+            constexpr std::string_view known = ct_detail::http_reason(Code);
+            ct_string<known.size()> text{};
+            for (std::size_t i = 0; i < known.size(); ++i) {
+                text.data[i] = known[i];
+            }
+            return text;
+        }
+    }();
+    static constexpr auto text = ct_string("HTTP/1.1 ") + ct_detail::decimal_text<Code>() + ct_string(" ") + reason +
+                                 ct_string("\r\n");
+};
+
+// One fixed header line, e.g. http_header<"Server", "edge">::text == "Server: edge\r\n"
+CT_STRING_EXPORT template<ct_string Name, ct_string Value>
+struct http_header {
+    static_assert(ct_detail::is_http_token(Name), "http_header: the name must be a non-empty token (RFC 9110)");
+    static_assert(ct_detail::is_http_field_value(Value), "http_header: the value must not contain CR, LF or other control characters");
+
+    static constexpr auto name = Name;
+    static constexpr auto value = Value;
+    static constexpr auto text = Name + ct_string(": ") + Value + ct_string("\r\n");
+};
+
+// The status line followed by the fixed header lines, as one constant. The blank line that
+// ends the header section is not included, so per-response fields can follow.
+//   constexpr const auto& head = http_preamble_v<http_status<200>, http_header<"Server", "edge">,
+//                                                http_header<"Content-Type", "text/html">>;
+CT_STRING_EXPORT template<typename Status, typename... Headers>
+inline constexpr auto http_preamble_v = (Status::text + ... + Headers::text);
+
+// A complete response whose body is also constant: the preamble, Content-Length, the blank
+// line and the body, e.g. a canned 404 page
+CT_STRING_EXPORT template<typename Status, ct_string Body, typename... Headers>
+inline constexpr auto http_response_v = http_preamble_v<Status, Headers...> + ct_string("Content-Length: ") +
+                                        ct_detail::decimal_text<Body.size()>() + ct_string("\r\n\r\n") + Body;
+
+// --- Sending ---
+
+// A header field whose value is only known at runtime
+CT_STRING_EXPORT struct http_field {
+    std::string_view name;
+    std::string_view value;
+};
+
+#if __has_include(<sys/uio.h>)
+
+// Writes preamble, then "name: value\r\n" for each field, the blank line and body, with one
+// writev() call unless the descriptor accepts less at a time. The preamble is sent from where
+// it is, normally an http_preamble_v constant. Returns false with errno set if the response
+// could not be written completely; EINVAL means more than 64 fields, or a field name that is
+// not a token or a value with CR, LF or other control characters, and nothing was written.
+//   write_http_response(fd, http_preamble_v<...>, {{{"Content-Length", length}}}, body);
+CT_STRING_EXPORT CT_STRING_KERNEL bool write_http_response(int fd, std::string_view preamble,
+                                                           std::span<const http_field> fields,
+                                                           std::string_view body = {}) {
+    constexpr std::size_t max_fields = 64;
+    // Room for every segment, and for all copied text of short names and values
+    using writer = iovec_writer<4 * max_fields + 3, 68 * max_fields + 64>;
+    if (fields.size() > max_fields) {
+        errno = EINVAL;
+        return false;
+    }
+    for (const http_field& field : fields) {
+        // Runtime values must not be able to end the header section early
+        if (!ct_detail::is_http_token(field.name) || !ct_detail::is_http_field_value(field.value)) {
+            errno = EINVAL;
+            return false;
+        }
+    }
+    writer out(fd);
+    out.append(preamble);
+    for (const http_field& field : fields) {
+        out.append(field.name).append<": ">().append(field.value).append<"\r\n">();
+    }
+    out.append<"\r\n">().append(body);
+    return out.flush();
+}
+
+#endif
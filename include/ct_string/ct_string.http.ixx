@@ -0,0 +1,17 @@
+module;
+
+#include <cerrno>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#define CT_STRING_MODULE_INTERFACE
+
+export module ct_string.http;
+
+export import ct_string.core;
+import ct_string.io;
+
+// ct_string.http.hpp with its public declarations exported
+#include "ct_string.http.hpp"
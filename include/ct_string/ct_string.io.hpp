@@ -0,0 +1,217 @@
+#pragma once
+
+// Scatter-gather output. An iovec_writer queues text as iovec segments: ct_string template
+// arguments and long runtime strings by pointer, without copying, and short fragments and
+// formatted numbers copied into a small inline buffer, merged with the previous segment when
+// they follow it there. flush() hands everything to the descriptor with writev() or sendmsg().
+
+#include "ct_string.config.hpp"
+
+#ifndef CT_STRING_MODULE_INTERFACE
+#include "ct_string.core.hpp"
+#include <cerrno>
+#include <charconv>     // For std::to_chars
+#include <concepts>
+#include <cstddef>
+#include <cstring>      // For std::memcpy
+#include <string_view>
+#include <type_traits>
+#if __has_include(<sys/uio.h>)
+#include <sys/socket.h> // For sendmsg
+#include <sys/uio.h>    // For writev
+#endif
+#endif
+
+#if __has_include(<sys/uio.h>)
+
+// How iovec_writer::flush() writes: writev() for any descriptor, sendmsg() for sockets, which
+// takes flags such as MSG_NOSIGNAL
+CT_STRING_EXPORT enum class iovec_flush { writev, sendmsg };
+
+namespace ct_detail {
+
+// Writes the whole of iov[0..count), resuming after partial writes and EINTR. Returns false
+// with errno set if the descriptor fails; iov is consumed either way.
+CT_STRING_KERNEL bool write_iovecs(int fd, struct iovec* iov, std::size_t count, iovec_flush how, int flags) {
+    while (count > 0) {
+        const std::size_t batch = count < 1024 ? count : 1024; // IOV_MAX on Linux and the BSDs
+        ssize_t written;
+        if (how == iovec_flush::sendmsg) {
+            struct msghdr message{};
+            message.msg_iov = iov;
+            message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(batch);
+            written = ::sendmsg(fd, &message, flags);
+        } else {
+            written = ::writev(fd, iov, static_cast<int>(batch));
+        }
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        auto rest = static_cast<std::size_t>(written);
+        while (count > 0 && rest >= iov->iov_len) {
+            rest -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + rest;
+            iov->iov_len -= rest;
+        }
+    }
+    return true;
+}
+
+#ifdef MSG_NOSIGNAL
+inline constexpr int default_send_flags = MSG_NOSIGNAL; // A closed peer is an error, not SIGPIPE
+#else
+inline constexpr int default_send_flags = 0;
+#endif
+
+} // namespace ct_detail
+
+// Collects up to Segments iovecs and BufferBytes of copied text, then writes them with one
+// call per flush(). Text shorter than CopyBelow bytes is copied, since a separate segment
+// costs more than the copy; everything else is referenced and must stay valid until the next
+// flush(). When either limit is reached, the queue is flushed before the new piece is added.
+//   iovec_writer out(fd);
+//   out.append<"HTTP/1.1 200 OK\r\nContent-Length: ">().append(body.size()).append<"\r\n\r\n">();
+//   out.append(body);
+//   if (!out.flush()) { ... errno ... }
+// A failed write discards the queue and makes later appends and flushes no-ops until clear().
+CT_STRING_EXPORT template<std::size_t Segments = 32, std::size_t BufferBytes = 512, std::size_t CopyBelow = 32>
+class iovec_writer {
+    static_assert(Segments > 0 && Segments <= 1024, "iovec_writer: Segments must be between 1 and IOV_MAX (1024)");
+    static_assert(CopyBelow <= BufferBytes, "iovec_writer: CopyBelow must not exceed BufferBytes");
+    static_assert(BufferBytes >= 32, "iovec_writer: BufferBytes must hold a formatted number");
+
+public:
+    explicit iovec_writer(int fd, iovec_flush how = iovec_flush::writev, int send_flags = ct_detail::default_send_flags)
+        : fd_(fd), how_(how), flags_(send_flags) {}
+
+    // The writer's segments point into its own buffer
+    iovec_writer(const iovec_writer&) = delete;
+    iovec_writer& operator=(const iovec_writer&) = delete;
+
+    // A constant: lives in static storage, so it is referenced however short it is, unless it
+    // is short enough to merge into the copied text before it
+    template<ct_string S>
+    iovec_writer& append() {
+        static_assert(std::is_same_v<typename decltype(S)::value_type, char>, "iovec_writer: only char strings can be written");
+        const std::string_view text(S);
+        if (text.size() < CopyBelow && follows_buffer()) {
+            return copy(text);
+        }
+        return reference(text);
+    }
+
+    // Runtime text: copied if shorter than CopyBelow, otherwise referenced until flush()
+    iovec_writer& append(std::string_view text) {
+        return text.size() < CopyBelow ? copy(text) : reference(text);
+    }
+
+    // Runtime text that will not outlive the call, always copied
+    iovec_writer& append_copy(std::string_view text) {
+        while (text.size() > BufferBytes) {
+            copy(text.substr(0, BufferBytes));
+            text.remove_prefix(BufferBytes);
+        }
+        return copy(text);
+    }
+
+    iovec_writer& append(char c) { return copy(std::string_view(&c, 1)); }
+
+    // Decimal text of an integer, or the shortest round-trip text of a floating-point number
+    template<typename T>
+        requires((std::integral<T> || std::floating_point<T>) && !std::same_as<T, char> && !std::same_as<T, bool>)
+    iovec_writer& append(T value) {
+        char digits[32];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        return copy(std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+    }
+
+    // Writes everything queued. Returns false with errno set if the descriptor failed, now or
+    // during an earlier automatic flush.
+    bool flush() {
+        if (failed_) {
+            errno = error_;
+            return false;
+        }
+        const bool written = ct_detail::write_iovecs(fd_, iov_, count_, how_, flags_);
+        count_ = 0;
+        used_ = 0;
+        if (!written) {
+            failed_ = true;
+            error_ = errno;
+        }
+        return written;
+    }
+
+    // Discards the queue and any failure
+    void clear() {
+        count_ = 0;
+        used_ = 0;
+        failed_ = false;
+    }
+
+    bool ok() const { return !failed_; }
+    std::size_t segments() const { return count_; }
+    std::size_t buffered_bytes() const { return used_; }
+
+    std::size_t pending_bytes() const {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < count_; ++i) {
+            total += iov_[i].iov_len;
+        }
+        return total;
+    }
+
+private:
+    // Whether the last segment is copied text, which the next copy extends
+    bool follows_buffer() const { return count_ > 0 && last_copied_; }
+
+    iovec_writer& reference(std::string_view text) {
+        if (text.empty() || failed_) {
+            return *this;
+        }
+        if (count_ == Segments && !flush()) {
+            return *this;
+        }
+        iov_[count_++] = {const_cast<char*>(text.data()), text.size()};
+        last_copied_ = false;
+        return *this;
+    }
+
+    iovec_writer& copy(std::string_view text) {
+        if (text.empty() || failed_) {
+            return *this;
+        }
+        if ((used_ + text.size() > BufferBytes || (count_ == Segments && !follows_buffer())) && !flush()) {
+            return *this;
+        }
+        std::memcpy(buffer_ + used_, text.data(), text.size());
+        if (follows_buffer()) {
+            iov_[count_ - 1].iov_len += text.size();
+        } else {
+            iov_[count_++] = {buffer_ + used_, text.size()};
+            last_copied_ = true;
+        }
+        used_ += text.size();
+        return *this;
+    }
+
+    int fd_;
+    iovec_flush how_;
+    int flags_;
+    bool failed_ = false;
+    bool last_copied_ = false;
+    int error_ = 0;
+    std::size_t count_ = 0;
+    std::size_t used_ = 0;
+    struct iovec iov_[Segments];
+    char buffer_[BufferBytes];
+};
+
+#endif
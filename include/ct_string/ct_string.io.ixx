@@ -0,0 +1,22 @@
+module;
+
+#include <cerrno>
+#include <charconv>     // For std::to_chars
+#include <concepts>
+#include <cstddef>
+#include <cstring>      // For std::memcpy
+#include <string_view>
+#include <type_traits>
+#if __has_include(<sys/uio.h>)
+#include <sys/socket.h> // For sendmsg
+#include <sys/uio.h>    // For writev
+#endif
+
+#define CT_STRING_MODULE_INTERFACE
+
+export module ct_string.io;
+
+export import ct_string.core;
+
+// ct_string.io.hpp with its public declarations exported
+#include "ct_string.io.hpp"
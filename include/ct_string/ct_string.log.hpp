@@ -0,0 +1,506 @@
+#pragma once
+
+// Deferred-formatting binary logging. The format string is a ct_string template argument, so
+// each call site has a static log_site record (format, argument kinds, source location) with a
+// 32-bit ID computed during compilation. ct_log() only copies that ID and the raw argument
+// bytes into the calling thread's ring buffer; formatting happens later, on the thread that
+// drains the rings (log_backend::start) or from records kept for offline decoding.
+
+#include "ct_string.config.hpp"
+
+#ifndef CT_STRING_MODULE_INTERFACE
+#include "ct_string.core.hpp"
+#include "ct_string.hash.hpp"
+#include "ct_string.source.hpp"
+#include <atomic>
+#include <bit>          // For std::bit_ceil
+#include <charconv>     // For std::to_chars when formatting
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>       // For the ID collision report
+#include <cstdlib>      // For std::abort
+#include <cstring>      // For std::memcpy
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#endif
+
+// --- Call-site metadata ---
+
+// How an argument is stored in a record: scalars as their own bytes, strings as a 32-bit
+// length followed by the characters. Enumerations are stored as their underlying type.
+CT_STRING_EXPORT enum class log_arg : std::uint8_t {
+    int8, int16, int32, int64, uint8, uint16, uint32, uint64,
+    float32, float64, boolean, character, string
+};
+
+// The static record of one ct_log call site
+CT_STRING_EXPORT struct log_site {
+    std::uint32_t id;
+    std::string_view format;
+    std::string_view file;
+    std::string_view function; // Empty unless the site was logged with ct_here()
+    std::uint32_t line;
+    std::span<const log_arg> args;
+};
+
+namespace ct_detail {
+
+template<typename>
+inline constexpr bool unsupported_log_arg = false;
+
+template<typename T>
+constexpr log_arg log_arg_of() {
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::is_same_v<U, bool>) {
+        return log_arg::boolean;
+    } else if constexpr (std::is_same_v<U, char>) {
+        return log_arg::character;
+    } else if constexpr (std::is_enum_v<U>) {
+        return log_arg_of<std::underlying_type_t<U>>();
+    } else if constexpr (std::is_integral_v<U>) {
+        constexpr log_arg signed_kinds[] = {log_arg::int8, log_arg::int16, log_arg::int32, log_arg::int64};
+        constexpr log_arg unsigned_kinds[] = {log_arg::uint8, log_arg::uint16, log_arg::uint32, log_arg::uint64};
+        static_assert(sizeof(U) <= 8, "ct_log: integers wider than 64 bits are not supported");
+        return (std::is_signed_v<U> ? signed_kinds : unsigned_kinds)[std::countr_zero(sizeof(U))];
+    } else if constexpr (std::is_same_v<U, float>) {
+        return log_arg::float32;
+    } else if constexpr (std::is_floating_point_v<U>) {
+        return log_arg::float64; // double, and long double narrowed to it
+    } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+        return log_arg::string;
+    } else {
+        static_assert(unsupported_log_arg<U>, "ct_log: arguments must be arithmetic, enumerations or convertible to std::string_view");
+        return log_arg::string;
+    }
+}
+
+// Number of {} placeholders in a format, or npos if it has a stray brace ({{ and }} are literal braces)
+constexpr std::size_t count_log_placeholders(std::string_view format) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        if (format[i] == '{' || format[i] == '}') {
+            if (i + 1 < format.size() && format[i + 1] == format[i]) {
+                ++i;
+            } else if (format[i] == '{' && i + 1 < format.size() && format[i + 1] == '}') {
+                ++count;
+                ++i;
+            } else {
+                return std::string_view::npos;
+            }
+        }
+    }
+    return count;
+}
+
+// CRC-32 of the format, location and argument kinds; 0 is reserved for ring padding
+template<ct_string Fmt, ct_string File, ct_string Function, std::uint32_t Line, log_arg... Args>
+constexpr std::uint32_t log_site_id() {
+    const char line_bytes[4] = {static_cast<char>(Line), static_cast<char>(Line >> 8),
+                                static_cast<char>(Line >> 16), static_cast<char>(Line >> 24)};
+    const char arg_bytes[sizeof...(Args) + 1] = {static_cast<char>(Args)..., 0};
+    std::uint32_t crc = crc32(static_cast<std::string_view>(Fmt));
+    crc = crc32(static_cast<std::string_view>(File), crc);
+    crc = crc32(static_cast<std::string_view>(Function), crc);
+    crc = crc32(std::string_view(line_bytes, 4), crc);
+    crc = crc32(std::string_view(arg_bytes, sizeof...(Args)), crc);
+    return crc == 0 ? 1 : crc;
+}
+
+struct log_site_table {
+    std::mutex mutex;
+    std::vector<const log_site*> sites;
+};
+
+CT_STRING_KERNEL log_site_table& log_sites() {
+    static log_site_table table;
+    return table;
+}
+
+// Makes a site known to find_log_site(). Two different sites with one ID would make records
+// undecodable, so that is reported and aborts; moving either call site by a line resolves it.
+CT_STRING_KERNEL bool register_log_site(const log_site& site) {
+    log_site_table& table = log_sites();
+    std::lock_guard lock(table.mutex);
+    for (const log_site* known : table.sites) {
+        if (known->id == site.id && known != &site) {
+            std::fprintf(stderr, "ct_log: call sites %.*s:%u and %.*s:%u share the ID %08x\n",
+                         static_cast<int>(known->file.size()), known->file.data(), known->line,
+                         static_cast<int>(site.file.size()), site.file.data(), site.line, site.id);
+            std::abort();
+        }
+    }
+    table.sites.push_back(&site);
+    return true;
+}
+
+template<ct_string Fmt, ct_string File, ct_string Function, std::uint32_t Line, log_arg... Args>
+struct log_site_record {
+    static constexpr log_arg args[sizeof...(Args) + 1] = {Args..., log_arg{}};
+    static constexpr log_site site = {log_site_id<Fmt, File, Function, Line, Args...>(), Fmt, File,
+                                      Function, Line, std::span<const log_arg>(args, sizeof...(Args))};
+    // Registered during static initialization, once per call site in the program
+    static inline const bool registered = register_log_site(site);
+};
+
+} // namespace ct_detail
+
+// The site a record's ID belongs to, or nullptr if no such call site was linked in
+CT_STRING_EXPORT CT_STRING_KERNEL const log_site* find_log_site(std::uint32_t id) {
+    ct_detail::log_site_table& table = ct_detail::log_sites();
+    std::lock_guard lock(table.mutex);
+    for (const log_site* site : table.sites) {
+        if (site->id == id) {
+            return site;
+        }
+    }
+    return nullptr;
+}
+
+// --- Ring buffer ---
+
+namespace ct_detail {
+
+// Each record starts with this header and is padded to a multiple of 8 bytes. A header with
+// id 0 marks the unused space at the end of the buffer before a record that did not fit there.
+struct log_record_header {
+    std::uint32_t id;
+    std::uint32_t size;
+};
+
+template<typename T>
+std::size_t log_arg_size(const T& value) {
+    if constexpr (log_arg_of<T>() == log_arg::string) {
+        return sizeof(std::uint32_t) + std::string_view(value).size();
+    } else if constexpr (log_arg_of<T>() == log_arg::float64) {
+        return sizeof(double);
+    } else if constexpr (std::is_enum_v<T>) {
+        return sizeof(std::underlying_type_t<T>);
+    } else {
+        return sizeof(T);
+    }
+}
+
+template<typename T>
+CT_STRING_ALWAYS_INLINE void put_log_arg(std::byte*& out, const T& value) {
+    if constexpr (log_arg_of<T>() == log_arg::string) {
+        const std::string_view text(value);
+        const auto size = static_cast<std::uint32_t>(text.size());
+        std::memcpy(out, &size, sizeof(size));
+        std::memcpy(out + sizeof(size), text.data(), text.size());
+        out += sizeof(size) + text.size();
+    } else if constexpr (log_arg_of<T>() == log_arg::float64) {
+        const auto stored = static_cast<double>(value);
+        std::memcpy(out, &stored, sizeof(stored));
+        out += sizeof(stored);
+    } else {
+        std::memcpy(out, &value, sizeof(value));
+        out += sizeof(value);
+    }
+}
+
+} // namespace ct_detail
+
+// A single-producer, single-consumer byte ring of log records. The producer never blocks:
+// a record that does not fit is dropped and counted. ct_log() gives every thread its own ring.
+CT_STRING_EXPORT class log_ring {
+public:
+    // capacity is rounded up to a power of two of at least 4096 bytes
+    explicit log_ring(std::size_t capacity)
+        : capacity_(std::bit_ceil(capacity < 4096 ? std::size_t{4096} : capacity)),
+          buffer_(std::make_unique<std::byte[]>(capacity_)) {}
+
+    // Producer side: appends one record. Records larger than half the ring are always dropped.
+    template<typename... Args>
+    bool write(std::uint32_t id, const Args&... args) {
+        const std::size_t payload = (std::size_t{0} + ... + ct_detail::log_arg_size(args));
+        const std::size_t size = (sizeof(ct_detail::log_record_header) + payload + 7) & ~std::size_t{7};
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t to_end = capacity_ - static_cast<std::size_t>(head & (capacity_ - 1));
+        const std::size_t needed = size <= to_end ? size : to_end + size;
+        if (size > capacity_ / 2 || !has_space(head, needed)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (size > to_end) {
+            const ct_detail::log_record_header padding = {0, static_cast<std::uint32_t>(to_end)};
+            std::memcpy(buffer_.get() + (head & (capacity_ - 1)), &padding, sizeof(padding));
+            head += to_end;
+        }
+        std::byte* out = buffer_.get() + (head & (capacity_ - 1));
+        const ct_detail::log_record_header header = {id, static_cast<std::uint32_t>(size)};
+        std::memcpy(out, &header, sizeof(header));
+        out += sizeof(header);
+        (ct_detail::put_log_arg(out, args), ...);
+        head_.store(head + size, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: calls visit(id, payload) for every record written so far, then frees
+    // their space. The payload may end with up to 7 padding bytes. Returns the record count.
+    template<typename Visitor>
+    std::size_t drain(Visitor&& visit) {
+        std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        const std::uint64_t head = head_.load(std::memory_order_acquire);
+        std::size_t count = 0;
+        while (tail != head) {
+            const std::byte* record = buffer_.get() + (tail & (capacity_ - 1));
+            ct_detail::log_record_header header;
+            std::memcpy(&header, record, sizeof(header));
+            if (header.id != 0) {
+                visit(header.id, std::span<const std::byte>(record + sizeof(header), header.size - sizeof(header)));
+                ++count;
+            }
+            tail += header.size;
+        }
+        tail_.store(tail, std::memory_order_release);
+        return count;
+    }
+
+    bool empty() const { return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire); }
+    std::size_t capacity() const { return capacity_; }
+    // Records rejected because the ring was full
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    bool has_space(std::uint64_t head, std::size_t needed) {
+        if (capacity_ - (head - cached_tail_) >= needed) {
+            return true;
+        }
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        return capacity_ - (head - cached_tail_) >= needed;
+    }
+
+    const std::size_t capacity_;
+    const std::unique_ptr<std::byte[]> buffer_;
+    // The producer's and the consumer's counters live on separate cache lines
+    alignas(64) std::atomic<std::uint64_t> head_{0};
+    std::uint64_t cached_tail_ = 0;
+    std::atomic<std::uint64_t> dropped_{0};
+    alignas(64) std::atomic<std::uint64_t> tail_{0};
+};
+
+// --- Formatting ---
+
+// The text of a record: the site's format with each {} replaced by the next argument
+CT_STRING_EXPORT CT_STRING_KERNEL std::string format_log_record(const log_site& site, std::span<const std::byte> payload) {
+    std::string text;
+    text.reserve(site.format.size() + payload.size());
+    const std::byte* in = payload.data();
+    std::size_t next_arg = 0;
+    const auto read = [&in](auto value) {
+        std::memcpy(&value, in, sizeof(value));
+        in += sizeof(value);
+        return value;
+    };
+    const auto append_number = [&text](auto value) {
+        char digits[32];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        text.append(digits, result.ptr);
+    };
+    for (std::size_t i = 0; i < site.format.size(); ++i) {
+        const char c = site.format[i];
+        if ((c == '{' || c == '}') && i + 1 < site.format.size() && site.format[i + 1] == c) {
+            text += c;
+            ++i;
+        } else if (c == '{' && next_arg < site.args.size()) {
+            ++i; // the closing brace, checked at compile time
+            switch (site.args[next_arg++]) {
+                case log_arg::int8: append_number(read(std::int8_t{})); break;
+                case log_arg::int16: append_number(read(std::int16_t{})); break;
+                case log_arg::int32: append_number(read(std::int32_t{})); break;
+                case log_arg::int64: append_number(read(std::int64_t{})); break;
+                case log_arg::uint8: append_number(read(std::uint8_t{})); break;
+                case log_arg::uint16: append_number(read(std::uint16_t{})); break;
+                case log_arg::uint32: append_number(read(std::uint32_t{})); break;
+                case log_arg::uint64: append_number(read(std::uint64_t{})); break;
+                case log_arg::float32: append_number(read(float{})); break;
+                case log_arg::float64: append_number(read(double{})); break;
+                case log_arg::boolean: text += read(bool{}) ? "true" : "false"; break;
+                case log_arg::character: text += read(char{}); break;
+                case log_arg::string: {
+                    const auto size = read(std::uint32_t{});
+                    text.append(reinterpret_cast<const char*>(in), size);
+                    in += size;
+                    break;
+                }
+            }
+        } else {
+            text += c;
+        }
+    }
+    return text;
+}
+
+// --- Backend ---
+
+// Owns the per-thread rings and the consumer side. drain() and the background thread started
+// by start() are the only consumers; calls to them are serialized.
+CT_STRING_EXPORT class log_backend {
+public:
+    using sink = std::function<void(const log_site& site, std::string_view message)>;
+
+    static log_backend& instance() {
+        static log_backend backend;
+        return backend;
+    }
+
+    ~log_backend() { stop(); }
+
+    // Capacity in bytes of rings created from now on (default 64 KiB per thread)
+    void set_ring_capacity(std::size_t bytes) { ring_capacity_.store(bytes, std::memory_order_relaxed); }
+
+    // The calling thread's ring, created on its first record
+    log_ring& this_thread_ring() {
+        thread_local ring_handle handle;
+        if (!handle.ring) [[unlikely]] {
+            handle.ring = std::make_shared<owned_ring>(ring_capacity_.load(std::memory_order_relaxed));
+            std::lock_guard lock(rings_mutex_);
+            rings_.push_back(handle.ring);
+        }
+        return handle.ring->ring;
+    }
+
+    // Calls visit(site, payload) for every record written so far, thread by thread in write
+    // order. Records of sites unknown to find_log_site() are skipped. Returns the record count.
+    template<typename Visitor>
+    std::size_t drain(Visitor&& visit) {
+        std::lock_guard consumer(consumer_mutex_);
+        std::vector<std::shared_ptr<owned_ring>> rings;
+        {
+            std::lock_guard lock(rings_mutex_);
+            rings = rings_;
+        }
+        std::size_t count = 0;
+        for (const auto& owned : rings) {
+            const bool closed = owned->closed.load(std::memory_order_acquire);
+            count += owned->ring.drain([&](std::uint32_t id, std::span<const std::byte> payload) {
+                if (const log_site* site = find_log_site(id)) {
+                    visit(*site, payload);
+                }
+            });
+            dropped_ += owned->ring.dropped() - owned->reported_drops;
+            owned->reported_drops = owned->ring.dropped();
+            if (closed) {
+                // The thread has exited and everything it wrote has been drained
+                std::lock_guard lock(rings_mutex_);
+                std::erase(rings_, owned);
+            }
+        }
+        return count;
+    }
+
+    // Formats records on a background thread every `period` and passes them to `out`
+    void start(sink out, std::chrono::milliseconds period = std::chrono::milliseconds(10)) {
+        stop();
+        std::lock_guard lock(thread_mutex_);
+        running_ = true;
+        worker_ = std::thread([this, out = std::move(out), period] {
+            const auto format = [&out](const log_site& site, std::span<const std::byte> payload) {
+                out(site, format_log_record(site, payload));
+            };
+            std::unique_lock lock(thread_mutex_);
+            while (running_) {
+                wake_.wait_for(lock, period, [this] { return !running_; });
+                lock.unlock();
+                drain(format);
+                lock.lock();
+            }
+            lock.unlock();
+            drain(format);
+        });
+    }
+
+    // Stops the background thread after it has drained what was written before the call
+    void stop() {
+        std::thread worker;
+        {
+            std::lock_guard lock(thread_mutex_);
+            running_ = false;
+            worker = std::move(worker_);
+        }
+        wake_.notify_all();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    // Records dropped because a ring was full, as of the last drain
+    std::uint64_t dropped() const {
+        std::lock_guard consumer(consumer_mutex_);
+        return dropped_;
+    }
+
+private:
+    struct owned_ring {
+        explicit owned_ring(std::size_t capacity) : ring(capacity) {}
+        log_ring ring;
+        std::atomic<bool> closed{false};
+        std::uint64_t reported_drops = 0;
+    };
+
+    // Marks the ring closed when its thread exits; the backend frees it once drained
+    struct ring_handle {
+        std::shared_ptr<owned_ring> ring;
+        ~ring_handle() {
+            if (ring) {
+                ring->closed.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    log_backend() = default;
+
+    std::atomic<std::size_t> ring_capacity_{std::size_t{1} << 16};
+    std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<owned_ring>> rings_;
+    mutable std::mutex consumer_mutex_;
+    std::uint64_t dropped_ = 0;
+    std::mutex thread_mutex_;
+    std::condition_variable wake_;
+    bool running_ = false;
+    std::thread worker_;
+};
+
+namespace ct_detail {
+
+template<ct_string Fmt, ct_string File, ct_string Function, std::uint32_t Line, typename... Args>
+CT_STRING_ALWAYS_INLINE bool write_log(const Args&... args) {
+    static_assert(std::is_same_v<typename decltype(Fmt)::value_type, char> &&
+                  std::is_same_v<typename decltype(File)::value_type, char>, "ct_log: format and file must be char strings");
+    static_assert(count_log_placeholders(Fmt) != std::string_view::npos,
+                  "ct_log: unmatched brace in format; write {{ and }} for literal braces");
+    static_assert(count_log_placeholders(Fmt) == sizeof...(Args),
+                  "ct_log: the number of {} placeholders differs from the number of arguments");
+    using record = log_site_record<Fmt, File, Function, Line, log_arg_of<Args>()...>;
+    (void)record::registered;
+    return log_backend::instance().this_thread_ring().write(record::site.id, args...);
+}
+
+} // namespace ct_detail
+
+// Logs one record from the calling thread. Fmt uses {} placeholders ({{ and }} for braces),
+// checked against the arguments at compile time; File and Line identify the call site:
+//   ct_log<"accepted {} from {}", __FILE__, __LINE__>(fd, peer_name);
+// The hot path stores the site ID and the argument bytes only. Returns false if the record
+// was dropped because the thread's ring was full.
+CT_STRING_EXPORT template<ct_string Fmt, ct_string File = "", std::uint32_t Line = 0, typename... Args>
+CT_STRING_ALWAYS_INLINE bool ct_log(const Args&... args) {
+    return ct_detail::write_log<Fmt, File, "", Line>(args...);
+}
+
+// The same, with the call site taken from ct_here(): its file (without the configured
+// prefixes), function and line are recorded in the site.
+//   ct_log<"accepted {} from {}", ct_here()>(fd, peer_name);
+CT_STRING_EXPORT template<ct_string Fmt, source_here Here, typename... Args>
+CT_STRING_ALWAYS_INLINE bool ct_log(const Args&... args) {
+    return ct_detail::write_log<Fmt, source_file_v<Here>, source_function_v<Here>, Here.line>(args...);
+}
@@ -0,0 +1,32 @@
+module;
+
+#include <atomic>
+#include <bit>          // For std::bit_ceil
+#include <charconv>     // For std::to_chars when formatting
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>       // For the ID collision report
+#include <cstdlib>      // For std::abort
+#include <cstring>      // For std::memcpy
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#define CT_STRING_MODULE_INTERFACE
+
+export module ct_string.log;
+
+export import ct_string.core;
+import ct_string.hash;
+export import ct_string.source; // ct_log<Fmt, ct_here()>
+
+// ct_string.log.hpp with its public declarations exported
+#include "ct_string.log.hpp"
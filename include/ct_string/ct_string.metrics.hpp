@@ -0,0 +1,385 @@
+#pragma once
+
+// Metrics declared by ct_string name. A metric_registry lists its counters, gauges and
+// histograms as template arguments, so every name resolves during compilation to a dense slot
+// index. Counters and histograms are sharded per thread: an update is a plain load and store
+// on a cache line only the calling thread writes, with no lookup, lock or atomic
+// read-modify-write. scrape() sums the shards; names come from one static string pool.
+
+#include "ct_string.config.hpp"
+
+#ifndef CT_STRING_MODULE_INTERFACE
+#include "ct_string.core.hpp"
+#include <array>
+#include <atomic>
+#include <charconv>     // For std::to_chars when writing the text format
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+#endif
+
+// --- Declarations ---
+
+CT_STRING_EXPORT enum class metric_kind : std::uint8_t { counter, gauge, histogram };
+
+// A monotonically increasing count, e.g. requests served
+CT_STRING_EXPORT template<ct_string Name>
+struct metric_counter {
+    static constexpr auto name = Name;
+    static constexpr metric_kind kind = metric_kind::counter;
+    static constexpr std::size_t shard_slots = 1;
+};
+
+// A value that goes up and down, e.g. open connections. Gauges support set(), which per-thread
+// shards cannot, so each one is a single atomic on its own cache line.
+CT_STRING_EXPORT template<ct_string Name>
+struct metric_gauge {
+    static constexpr auto name = Name;
+    static constexpr metric_kind kind = metric_kind::gauge;
+    static constexpr std::size_t shard_slots = 0;
+};
+
+// Counts of observed values per bucket, where bucket i holds values <= Bounds[i] and the last
+// bucket everything larger, plus the sum of all observations. Bounds must be increasing.
+CT_STRING_EXPORT template<ct_string Name, std::uint64_t... Bounds>
+struct metric_histogram {
+    static constexpr auto name = Name;
+    static constexpr metric_kind kind = metric_kind::histogram;
+    static constexpr std::array<std::uint64_t, sizeof...(Bounds)> bounds = {Bounds...};
+    static constexpr std::size_t bucket_count = sizeof...(Bounds) + 1;
+    static constexpr std::size_t shard_slots = bucket_count + 1; // the buckets, then the sum
+};
+
+// A histogram's buckets and sum as of a scrape
+CT_STRING_EXPORT template<std::size_t BucketCount>
+struct histogram_values {
+    std::array<std::uint64_t, BucketCount> buckets{};
+    std::uint64_t sum = 0;
+
+    std::uint64_t count() const {
+        std::uint64_t total = 0;
+        for (const std::uint64_t n : buckets) {
+            total += n;
+        }
+        return total;
+    }
+};
+
+namespace ct_detail {
+
+// Prometheus metric names: [a-zA-Z_:][a-zA-Z0-9_:]*
+constexpr bool is_metric_name(std::string_view name) {
+    if (name.empty() || (name[0] >= '0' && name[0] <= '9')) {
+        return false;
+    }
+    for (const char c : name) {
+        const bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                           c == '_' || c == ':';
+        if (!valid) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Metric>
+constexpr bool histogram_bounds_increasing() {
+    if constexpr (Metric::kind == metric_kind::histogram) {
+        for (std::size_t i = 1; i < Metric::bounds.size(); ++i) {
+            if (Metric::bounds[i] <= Metric::bounds[i - 1]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<typename T>
+void append_metric_number(std::string& out, T value) {
+    char digits[24];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+} // namespace ct_detail
+
+// --- Registry ---
+
+// One set of metrics with its per-thread shards, e.g.
+//   using metrics = metric_registry<metric_counter<"http_requests_total">,
+//                                   metric_gauge<"http_connections">,
+//                                   metric_histogram<"http_latency_us", 100, 1000, 10000>>;
+//   metrics::increment<"http_requests_total">();
+//   metrics::observe<"http_latency_us">(elapsed_us);
+// Each registry type has its own storage; a name that is not declared is a compile error.
+CT_STRING_EXPORT template<typename... Metrics>
+class metric_registry {
+    static_assert(sizeof...(Metrics) > 0, "metric_registry: at least one metric is required");
+    static_assert((ct_detail::is_metric_name(Metrics::name) && ...),
+                  "metric_registry: names must match [a-zA-Z_:][a-zA-Z0-9_:]*");
+    static_assert((ct_detail::histogram_bounds_increasing<Metrics>() && ...),
+                  "metric_registry: histogram bounds must be increasing");
+
+    static constexpr std::size_t metric_count = sizeof...(Metrics);
+    static constexpr std::string_view names[metric_count] = {std::string_view(Metrics::name)...};
+    static constexpr metric_kind kinds[metric_count] = {Metrics::kind...};
+
+    static constexpr bool names_unique() {
+        for (std::size_t a = 0; a < metric_count; ++a) {
+            for (std::size_t b = a + 1; b < metric_count; ++b) {
+                if (names[a] == names[b]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    static_assert(names_unique(), "metric_registry: metric names must be unique");
+
+    // The first shard slot of each metric; gauges instead get the next index into the gauges
+    struct layout {
+        std::array<std::size_t, metric_count> slot{};
+        std::size_t shard_slots = 0;
+        std::size_t gauge_count = 0;
+    };
+
+    static constexpr layout plan = [] {
+        layout out{};
+        const std::size_t sizes[metric_count] = {Metrics::shard_slots...};
+        for (std::size_t i = 0; i < metric_count; ++i) {
+            if (kinds[i] == metric_kind::gauge) {
+                out.slot[i] = out.gauge_count++;
+            } else {
+                out.slot[i] = out.shard_slots;
+                out.shard_slots += sizes[i];
+            }
+        }
+        return out;
+    }();
+
+    template<ct_string Name>
+    static constexpr std::size_t find() {
+        for (std::size_t i = 0; i < metric_count; ++i) {
+            if (names[i] == std::string_view(Name)) {
+                return i;
+            }
+        }
+        return metric_count;
+    }
+
+    template<ct_string Name>
+    static constexpr std::size_t index_of() {
+        constexpr std::size_t index = find<Name>();
+        static_assert(index < metric_count, "metric_registry: no metric with this name is declared");
+        return index;
+    }
+
+    template<std::size_t I>
+    using metric_at = std::tuple_element_t<I, std::tuple<Metrics...>>;
+
+    // The slots one thread writes. Shards are cache-line aligned and sized, so two threads'
+    // shards never share a line.
+    struct alignas(64) shard {
+        std::array<std::atomic<std::uint64_t>, plan.shard_slots == 0 ? 1 : plan.shard_slots> slots{};
+    };
+
+    struct alignas(64) padded_gauge {
+        std::atomic<std::int64_t> value{0};
+    };
+
+    struct state {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<shard>> shards;
+        // What exited threads had counted
+        std::array<std::uint64_t, plan.shard_slots> retired{};
+        std::array<padded_gauge, plan.gauge_count == 0 ? 1 : plan.gauge_count> gauges{};
+    };
+
+    static state& storage() {
+        static state s;
+        return s;
+    }
+
+    // Folds the shard into the retired totals when its thread exits
+    struct shard_handle {
+        std::shared_ptr<shard> owned;
+        ~shard_handle() {
+            if (owned) {
+                state& s = storage();
+                std::lock_guard lock(s.mutex);
+                for (std::size_t i = 0; i < plan.shard_slots; ++i) {
+                    s.retired[i] += owned->slots[i].load(std::memory_order_relaxed);
+                }
+                std::erase(s.shards, owned);
+            }
+        }
+    };
+
+    static void attach(shard_handle& handle) {
+        handle.owned = std::make_shared<shard>();
+        state& s = storage();
+        std::lock_guard lock(s.mutex);
+        s.shards.push_back(handle.owned);
+    }
+
+    // The calling thread's shard, created on its first update
+    CT_STRING_ALWAYS_INLINE static shard& this_thread_shard() {
+        thread_local shard_handle handle;
+        if (!handle.owned) [[unlikely]] {
+            attach(handle);
+        }
+        return *handle.owned;
+    }
+
+    // Only the owning thread writes a shard slot, so a relaxed load and store suffice
+    CT_STRING_ALWAYS_INLINE static void bump(std::atomic<std::uint64_t>& slot, std::uint64_t n) {
+        slot.store(slot.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+public:
+    // All names back to back; name(i) points into it
+    static constexpr auto name_pool = (Metrics::name + ...);
+
+    static constexpr std::size_t size() { return metric_count; }
+
+    static constexpr std::string_view name(std::size_t i) {
+        std::size_t offset = 0;
+        for (std::size_t j = 0; j < i; ++j) {
+            offset += names[j].size();
+        }
+        return std::string_view(name_pool).substr(offset, names[i].size());
+    }
+
+    static constexpr metric_kind kind(std::size_t i) { return kinds[i]; }
+
+    template<ct_string Name>
+    CT_STRING_ALWAYS_INLINE static void increment(std::uint64_t n = 1) {
+        constexpr std::size_t index = index_of<Name>();
+        static_assert(kinds[index] == metric_kind::counter, "metric_registry: increment() needs a counter");
+        bump(this_thread_shard().slots[plan.slot[index]], n);
+    }
+
+    template<ct_string Name>
+    static void set(std::int64_t value) {
+        constexpr std::size_t index = index_of<Name>();
+        static_assert(kinds[index] == metric_kind::gauge, "metric_registry: set() needs a gauge");
+        storage().gauges[plan.slot[index]].value.store(value, std::memory_order_relaxed);
+    }
+
+    template<ct_string Name>
+    static void add(std::int64_t delta) {
+        constexpr std::size_t index = index_of<Name>();
+        static_assert(kinds[index] == metric_kind::gauge, "metric_registry: add() needs a gauge");
+        storage().gauges[plan.slot[index]].value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    template<ct_string Name>
+    CT_STRING_ALWAYS_INLINE static void observe(std::uint64_t value) {
+        constexpr std::size_t index = index_of<Name>();
+        static_assert(kinds[index] == metric_kind::histogram, "metric_registry: observe() needs a histogram");
+        using metric = metric_at<index>;
+        std::size_t bucket = 0;
+        while (bucket < metric::bounds.size() && value > metric::bounds[bucket]) {
+            ++bucket;
+        }
+        shard& mine = this_thread_shard();
+        bump(mine.slots[plan.slot[index] + bucket], 1);
+        bump(mine.slots[plan.slot[index] + metric::bucket_count], value);
+    }
+
+    // The summed shards and the gauges at one point in time
+    class snapshot {
+    public:
+        // A counter's count, a gauge's value or a histogram's histogram_values
+        template<ct_string Name>
+        auto get() const {
+            constexpr std::size_t index = index_of<Name>();
+            constexpr std::size_t slot = plan.slot[index];
+            if constexpr (kinds[index] == metric_kind::counter) {
+                return slots_[slot];
+            } else if constexpr (kinds[index] == metric_kind::gauge) {
+                return gauges_[slot];
+            } else {
+                histogram_values<metric_at<index>::bucket_count> out;
+                for (std::size_t b = 0; b < out.buckets.size(); ++b) {
+                    out.buckets[b] = slots_[slot + b];
+                }
+                out.sum = slots_[slot + out.buckets.size()];
+                return out;
+            }
+        }
+
+        // The Prometheus text exposition format, cumulative buckets included
+        std::string to_prometheus() const {
+            std::string out;
+            std::size_t i = 0;
+            (write_metric<Metrics>(out, i++), ...);
+            return out;
+        }
+
+    private:
+        friend class metric_registry;
+
+        template<typename Metric>
+        void write_metric(std::string& out, std::size_t i) const {
+            static constexpr std::string_view type_names[] = {"counter", "gauge", "histogram"};
+            const std::string_view metric_name = name(i);
+            const std::size_t slot = plan.slot[i];
+            out.append("# TYPE ").append(metric_name).append(" ");
+            out.append(type_names[static_cast<std::size_t>(Metric::kind)]).append("\n");
+            if constexpr (Metric::kind == metric_kind::histogram) {
+                std::uint64_t cumulative = 0;
+                for (std::size_t b = 0; b < Metric::bucket_count; ++b) {
+                    cumulative += slots_[slot + b];
+                    out.append(metric_name).append("_bucket{le=\"");
+                    if (b < Metric::bounds.size()) {
+                        ct_detail::append_metric_number(out, Metric::bounds[b]);
+                    } else {
+                        out.append("+Inf");
+                    }
+                    out.append("\"} ");
+                    ct_detail::append_metric_number(out, cumulative);
+                    out.append("\n");
+                }
+                out.append(metric_name).append("_sum ");
+                ct_detail::append_metric_number(out, slots_[slot + Metric::bucket_count]);
+                out.append("\n").append(metric_name).append("_count ");
+                ct_detail::append_metric_number(out, cumulative);
+            } else {
+                out.append(metric_name).append(" ");
+                if constexpr (Metric::kind == metric_kind::gauge) {
+                    ct_detail::append_metric_number(out, gauges_[slot]);
+                } else {
+                    ct_detail::append_metric_number(out, slots_[slot]);
+                }
+            }
+            out.append("\n");
+        }
+
+        std::array<std::uint64_t, plan.shard_slots> slots_{};
+        std::array<std::int64_t, plan.gauge_count> gauges_{};
+    };
+
+    // Sums the live shards and what exited threads counted. Updates racing with the scrape
+    // land in this one or the next; none is lost or counted twice.
+    static snapshot scrape() {
+        snapshot out;
+        state& s = storage();
+        std::lock_guard lock(s.mutex);
+        out.slots_ = s.retired;
+        for (const auto& owned : s.shards) {
+            for (std::size_t i = 0; i < plan.shard_slots; ++i) {
+                out.slots_[i] += owned->slots[i].load(std::memory_order_relaxed);
+            }
+        }
+        for (std::size_t g = 0; g < plan.gauge_count; ++g) {
+            out.gauges_[g] = s.gauges[g].value.load(std::memory_order_relaxed);
+        }
+        return out;
+    }
+};
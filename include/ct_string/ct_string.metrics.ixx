@@ -0,0 +1,22 @@
+module;
+
+#include <array>
+#include <atomic>
+#include <charconv>     // For std::to_chars when writing the text format
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#define CT_STRING_MODULE_INTERFACE
+
+export module ct_string.metrics;
+
+export import ct_string.core;
+
+// ct_string.metrics.hpp with its public declarations exported
+#include "ct_string.metrics.hpp"
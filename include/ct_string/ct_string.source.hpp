@@ -0,0 +1,164 @@
+#pragma once
+
+// Source locations at compile time: ct_here() captures the call site's file, function, line and
+// column, with the build directory stripped from the path, as a value that can be passed as a
+// template argument. Kept out of ct_string.core so that <source_location> is only paid for by
+// the translation units that use it.
+
+#include "ct_string.config.hpp"
+
+#ifndef CT_STRING_MODULE_INTERFACE
+#include "ct_string.core.hpp"
+#include <concepts>        // For std::same_as
+#include <cstddef>
+#include <cstdint>         // For std::uint_least32_t
+#include <source_location>
+#include <string_view>
+#endif
+
+// Prefixes ct_here() strips from file paths by default, separated by '|'. The ct_string CMake
+// targets set it to the top-level source and binary directories (CT_STRING_SOURCE_PREFIXES).
+#ifndef CT_STRING_SOURCE_PREFIXES
+#define CT_STRING_SOURCE_PREFIXES ""
+#endif
+
+// Characters source_here keeps of the file path and of the function name. GCC spells out the
+// template arguments of templates and lambdas in function names, which can take more.
+#ifndef CT_STRING_SOURCE_TEXT_CAPACITY
+#define CT_STRING_SOURCE_TEXT_CAPACITY 256
+#endif
+
+namespace ct_detail {
+
+// Longer file paths keep their last characters after "...", longer function names their first
+// before "...", so a shortened text is never mistaken for a complete one
+inline constexpr std::size_t source_text_capacity = CT_STRING_SOURCE_TEXT_CAPACITY;
+static_assert(source_text_capacity >= 16, "CT_STRING_SOURCE_TEXT_CAPACITY must be at least 16");
+inline constexpr std::string_view source_text_ellipsis = "...";
+
+constexpr bool is_path_separator(char c) {
+    return c == '/' || c == '\\';
+}
+
+// Copies n characters; the texts are short, so no blocking is needed
+constexpr void copy_source_text(const char* from, std::size_t n, char* to) {
+    for (std::size_t i = 0; i < n; ++i) {
+        to[i] = from[i];
+    }
+}
+
+// Whether path starts with prefix, treating '/' and '\' as the same character
+constexpr bool starts_with_path(std::string_view path, std::string_view prefix) {
+    if (prefix.empty() || prefix.size() > path.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < prefix.size(); ++i) {
+        if (path[i] != prefix[i] && !(is_path_separator(path[i]) && is_path_separator(prefix[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Length of the longest of the '|'-separated prefixes that path starts with
+constexpr std::size_t source_prefix_length(std::string_view path, std::string_view prefixes) {
+    std::size_t longest = 0;
+    while (!prefixes.empty()) {
+        const std::size_t end = prefixes.find('|');
+        const std::string_view prefix = prefixes.substr(0, end);
+        if (starts_with_path(path, prefix) && prefix.size() > longest) {
+            longest = prefix.size();
+        }
+        prefixes = end == std::string_view::npos ? std::string_view{} : prefixes.substr(end + 1);
+    }
+    return longest;
+}
+
+} // namespace ct_detail
+
+// A call site's file, function, line and column as a structural value, so it can be passed as
+// a template argument (to source_file_v and friends, or ct_log). Made by ct_here().
+CT_STRING_EXPORT struct source_here {
+    char file_text[ct_detail::source_text_capacity];
+    std::size_t file_size;
+    char function_text[ct_detail::source_text_capacity];
+    std::size_t function_size;
+    std::uint_least32_t line;
+    std::uint_least32_t column;
+
+    constexpr std::string_view file() const { return {file_text, file_size}; }
+    constexpr std::string_view function() const { return {function_text, function_size}; }
+    // The file name without its directories
+    constexpr std::string_view basename() const {
+        std::size_t start = file_size;
+        while (start > 0 && !ct_detail::is_path_separator(file_text[start - 1])) {
+            --start;
+        }
+        return file().substr(start);
+    }
+};
+
+// The location of the call, with the longest matching prefix stripped from the file path:
+// one of Prefixes..., or of CT_STRING_SOURCE_PREFIXES when none are given. Evaluated during
+// compilation, so the unstripped path is never stored in the binary.
+//   constexpr auto here = ct_here();                  // here.file() == "src/net/server.cpp"
+//   constexpr auto name = source_basename_v<ct_here()>; // ct_string("server.cpp")
+CT_STRING_EXPORT template<ct_string... Prefixes>
+consteval source_here ct_here(std::source_location where = std::source_location::current()) {
+    static_assert((std::same_as<typename decltype(Prefixes)::value_type, char> && ...),
+                  "ct_here: prefixes must be char strings");
+    const std::string_view path(where.file_name(), std::char_traits<char>::length(where.file_name()));
+    std::size_t strip = 0;
+    if constexpr (sizeof...(Prefixes) == 0) {
+        strip = ct_detail::source_prefix_length(path, CT_STRING_SOURCE_PREFIXES);
+    } else {
+        ((strip = ct_detail::starts_with_path(path, Prefixes) && Prefixes.size() > strip ? Prefixes.size() : strip), ...);
+    }
+    constexpr std::size_t capacity = ct_detail::source_text_capacity;
+    constexpr std::string_view ellipsis = ct_detail::source_text_ellipsis;
+    source_here here{};
+
+    std::string_view file = path.substr(strip);
+    if (file.size() > capacity) {
+        file = file.substr(file.size() - (capacity - ellipsis.size()));
+        ct_detail::copy_source_text(ellipsis.data(), ellipsis.size(), here.file_text);
+        here.file_size = ellipsis.size();
+    }
+    ct_detail::copy_source_text(file.data(), file.size(), here.file_text + here.file_size);
+    here.file_size += file.size();
+
+    std::string_view function(where.function_name(), std::char_traits<char>::length(where.function_name()));
+    if (function.size() > capacity) {
+        function = function.substr(0, capacity - ellipsis.size());
+        ct_detail::copy_source_text(ellipsis.data(), ellipsis.size(), here.function_text + function.size());
+        here.function_size = ellipsis.size();
+    }
+    ct_detail::copy_source_text(function.data(), function.size(), here.function_text);
+    here.function_size += function.size();
+    here.line = where.line();
+    here.column = where.column();
+    return here;
+}
+
+// The parts of a location as ct_strings of exactly their length
+CT_STRING_EXPORT template<source_here Here>
+inline constexpr auto source_file_v = [] {
+    ct_string<Here.file_size> text{};
+    ct_detail::copy_source_text(Here.file_text, Here.file_size, text.data.data());
+    return text;
+}();
+
+CT_STRING_EXPORT template<source_here Here>
+inline constexpr auto source_basename_v = [] {
+    constexpr std::string_view name = Here.basename();
+    ct_string<name.size()> text{};
+    ct_detail::copy_source_text(name.data(), name.size(), text.data.data());
+    return text;
+}();
+
+CT_STRING_EXPORT template<source_here Here>
+inline constexpr auto source_function_v = [] {
+    ct_string<Here.function_size> text{};
+    ct_detail::copy_source_text(Here.function_text, Here.function_size, text.data.data());
+    return text;
+}();
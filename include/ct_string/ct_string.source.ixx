@@ -0,0 +1,16 @@
+module;
+
+#include <concepts>        // For std::same_as
+#include <cstddef>
+#include <cstdint>         // For std::uint_least32_t
+#include <source_location>
+#include <string_view>
+
+#define CT_STRING_MODULE_INTERFACE
+
+export module ct_string.source;
+
+export import ct_string.core;
+
+// ct_string.source.hpp with its public declarations exported
+#include "ct_string.source.hpp"
@@ -0,0 +1,553 @@
+#pragma once
+
+// UTF-8/16/32 transcoding, text properties (validity, code points, display width) and
+// NFC/NFD/NFKC/NFKD normalization, with the generated Unicode tables
+
+#include "ct_string.config.hpp"
+
+#ifndef CT_STRING_MODULE_INTERFACE
+#include "ct_string.core.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>     // For fixed-width code unit types
+#include <algorithm>   // For std::sort, std::upper_bound
+#include <string>      // For normalize()
+#include <string_view>
+#include <type_traits>
+#include <vector>      // For transient storage in constexpr normalization
+#endif
+
+// --- Unicode transcoding ---
+
+// Helpers shared by the encoding-aware algorithms below. Not exported.
+namespace ct_detail {
+
+enum class utf { utf8, utf16, utf32 };
+
+// Encoding implied by a character type. char is treated as UTF-8, wchar_t follows its width
+// (UTF-16 on Windows, UTF-32 elsewhere).
+template<typename CharT>
+constexpr utf encoding_of() {
+    if constexpr (sizeof(CharT) == 1) {
+        return utf::utf8;
+    } else if constexpr (sizeof(CharT) == 2) {
+        return utf::utf16;
+    } else {
+        return utf::utf32;
+    }
+}
+
+// Returned by decode() for malformed input
+inline constexpr char32_t invalid_code_point = 0xFFFFFFFF;
+
+constexpr bool is_surrogate(char32_t cp) { return cp >= 0xD800 && cp <= 0xDFFF; }
+constexpr bool is_scalar_value(char32_t cp) { return cp <= 0x10FFFF && !is_surrogate(cp); }
+
+// Decodes one code point starting at str[i] and advances i past it.
+// Rejects overlong UTF-8, surrogates, unpaired UTF-16 surrogates and values above U+10FFFF.
+template<typename CharT>
+constexpr char32_t decode(const CharT* str, std::size_t n, std::size_t& i) {
+    if constexpr (encoding_of<CharT>() == utf::utf8) {
+        const auto lead = static_cast<unsigned char>(str[i++]);
+        if (lead < 0x80) {
+            return lead;
+        }
+        std::size_t extra = 0;
+        char32_t cp = 0;
+        char32_t min = 0;
+        if ((lead & 0xE0) == 0xC0) { extra = 1; cp = lead & 0x1F; min = 0x80; }
+        else if ((lead & 0xF0) == 0xE0) { extra = 2; cp = lead & 0x0F; min = 0x800; }
+        else if ((lead & 0xF8) == 0xF0) { extra = 3; cp = lead & 0x07; min = 0x10000; }
+        else { return invalid_code_point; }
+        for (std::size_t k = 0; k < extra; ++k) {
+            if (i == n) {
+                return invalid_code_point;
+            }
+            const auto cont = static_cast<unsigned char>(str[i]);
+            if ((cont & 0xC0) != 0x80) {
+                return invalid_code_point;
+            }
+            cp = (cp << 6) | (cont & 0x3F);
+            ++i;
+        }
+        return (cp < min || !is_scalar_value(cp)) ? invalid_code_point : cp;
+    } else if constexpr (encoding_of<CharT>() == utf::utf16) {
+        const auto unit = static_cast<char32_t>(static_cast<std::uint16_t>(str[i++]));
+        if (!is_surrogate(unit)) {
+            return unit;
+        }
+        if (unit >= 0xDC00 || i == n) {
+            return invalid_code_point;
+        }
+        const auto low = static_cast<char32_t>(static_cast<std::uint16_t>(str[i]));
+        if (low < 0xDC00 || low > 0xDFFF) {
+            return invalid_code_point;
+        }
+        ++i;
+        return 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+    } else {
+        const auto cp = static_cast<char32_t>(str[i++]);
+        return is_scalar_value(cp) ? cp : invalid_code_point;
+    }
+}
+
+// Number of code units needed to encode cp in the encoding of CharT
+template<typename CharT>
+constexpr std::size_t encoded_units(char32_t cp) {
+    if constexpr (encoding_of<CharT>() == utf::utf8) {
+        return cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+    } else if constexpr (encoding_of<CharT>() == utf::utf16) {
+        return cp < 0x10000 ? 1 : 2;
+    } else {
+        return 1;
+    }
+}
+
+// Writes cp at out[o] and advances o
+template<typename CharT>
+constexpr void encode(char32_t cp, CharT* out, std::size_t& o) {
+    if constexpr (encoding_of<CharT>() == utf::utf8) {
+        if (cp < 0x80) {
+            out[o++] = static_cast<CharT>(cp);
+        } else if (cp < 0x800) {
+            out[o++] = static_cast<CharT>(0xC0 | (cp >> 6));
+            out[o++] = static_cast<CharT>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out[o++] = static_cast<CharT>(0xE0 | (cp >> 12));
+            out[o++] = static_cast<CharT>(0x80 | ((cp >> 6) & 0x3F));
+            out[o++] = static_cast<CharT>(0x80 | (cp & 0x3F));
+        } else {
+            out[o++] = static_cast<CharT>(0xF0 | (cp >> 18));
+            out[o++] = static_cast<CharT>(0x80 | ((cp >> 12) & 0x3F));
+            out[o++] = static_cast<CharT>(0x80 | ((cp >> 6) & 0x3F));
+            out[o++] = static_cast<CharT>(0x80 | (cp & 0x3F));
+        }
+    } else if constexpr (encoding_of<CharT>() == utf::utf16) {
+        if (cp < 0x10000) {
+            out[o++] = static_cast<CharT>(cp);
+        } else {
+            out[o++] = static_cast<CharT>(0xD800 + ((cp - 0x10000) >> 10));
+            out[o++] = static_cast<CharT>(0xDC00 + ((cp - 0x10000) & 0x3FF));
+        }
+    } else {
+        out[o++] = static_cast<CharT>(cp);
+    }
+}
+
+template<typename CharT>
+constexpr bool is_valid_encoding(const CharT* str, std::size_t n) {
+    for (std::size_t i = 0; i < n;) {
+        for (const std::size_t end = block_end(i, n); i < end;) {
+            if (decode(str, n, i) == invalid_code_point) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Length of str re-encoded with OutCharT. Only meaningful for valid input.
+template<typename OutCharT, typename CharT>
+constexpr std::size_t transcoded_length(const CharT* str, std::size_t n) {
+    std::size_t len = 0;
+    for (std::size_t i = 0; i < n;) {
+        for (const std::size_t end = block_end(i, n); i < end;) {
+            len += encoded_units<OutCharT>(decode(str, n, i));
+        }
+    }
+    return len;
+}
+
+template<typename OutCharT, ct_string S>
+constexpr auto transcode() {
+    static_assert(is_valid_encoding(S.c_str(), S.size()),
+                  "ct_string transcoding: input is not well-formed UTF-8/UTF-16/UTF-32");
+    ct_string<transcoded_length<OutCharT>(S.c_str(), S.size()), OutCharT> result{};
+    std::size_t o = 0;
+    for (std::size_t i = 0; i < S.size();) {
+        for (const std::size_t end = block_end(i, S.size()); i < end;) {
+            encode(decode(S.c_str(), S.size(), i), result.data.data(), o);
+        }
+    }
+    return result;
+}
+
+// Evaluated once per (OutCharT, S)
+template<typename OutCharT, ct_string S>
+inline constexpr auto transcoded_v = transcode<OutCharT, S>();
+
+} // namespace ct_detail
+
+// Re-encode a ct_string at compile time. The encoding of the input is implied by its
+// character type (char and char8_t: UTF-8, char16_t: UTF-16, char32_t: UTF-32, wchar_t: by width).
+// The result has exactly the number of code units needed; malformed input fails a static_assert.
+// Example: constexpr auto label = to_utf16<"Grüße">(); // ct_string<5, char16_t>
+CT_STRING_EXPORT template<ct_string S>
+constexpr auto to_utf8() {
+    return ct_detail::transcoded_v<char8_t, S>;
+}
+
+CT_STRING_EXPORT template<ct_string S>
+constexpr auto to_utf16() {
+    return ct_detail::transcoded_v<char16_t, S>;
+}
+
+CT_STRING_EXPORT template<ct_string S>
+constexpr auto to_utf32() {
+    return ct_detail::transcoded_v<char32_t, S>;
+}
+
+// --- Text properties ---
+
+namespace ct_detail {
+
+struct code_point_range {
+    char32_t first;
+    char32_t last;
+};
+
+// zero_width_ranges[] and wide_ranges[], sorted and non-overlapping
+#include "unicode_tables.inc"
+
+template<std::size_t M>
+constexpr bool in_ranges(const code_point_range (&table)[M], char32_t cp) {
+    std::size_t lo = 0;
+    std::size_t hi = M;
+    while (lo < hi) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (cp < table[mid].first) {
+            hi = mid;
+        } else if (cp > table[mid].last) {
+            lo = mid + 1;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Terminal columns taken by cp: 0 for controls, combining marks and format characters,
+// 2 for East Asian Wide/Fullwidth characters (CJK, emoji), 1 otherwise.
+constexpr std::size_t code_point_width(char32_t cp) {
+    if (cp < 0x20 || (cp >= 0x7F && cp < 0xA0)) {
+        return 0;
+    }
+    if (cp < 0x300) {
+        return 1; // Fast path: nothing below U+0300 is wide or zero width (besides controls)
+    }
+    if (in_ranges(zero_width_ranges, cp)) {
+        return 0;
+    }
+    return in_ranges(wide_ranges, cp) ? 2 : 1;
+}
+
+template<typename CharT>
+constexpr bool is_ascii(const CharT* str, std::size_t n) {
+    for (std::size_t block = 0; block < n; block += constexpr_block) {
+        const std::size_t end = block_end(block, n);
+        for (std::size_t i = block; i < end; ++i) {
+            // Compare as unsigned so that negative plain chars are not mistaken for ASCII
+            if (static_cast<std::make_unsigned_t<CharT>>(str[i]) > 0x7F) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<typename CharT>
+constexpr bool contains_nul(const CharT* str, std::size_t n) {
+    for (std::size_t block = 0; block < n; block += constexpr_block) {
+        const std::size_t end = block_end(block, n);
+        for (std::size_t i = block; i < end; ++i) {
+            if (str[i] == CharT{}) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template<typename CharT>
+constexpr std::size_t codepoint_count(const CharT* str, std::size_t n) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n;) {
+        for (const std::size_t end = block_end(i, n); i < end; ++count) {
+            decode(str, n, i);
+        }
+    }
+    return count;
+}
+
+template<typename CharT>
+constexpr std::size_t display_width(const CharT* str, std::size_t n) {
+    std::size_t width = 0;
+    for (std::size_t i = 0; i < n;) {
+        for (const std::size_t end = block_end(i, n); i < end;) {
+            width += code_point_width(decode(str, n, i));
+        }
+    }
+    return width;
+}
+
+} // namespace ct_detail
+
+// Properties of a ct_string, computed once at compile time so that runtime code can
+// select fast paths with `if constexpr` instead of scanning the string.
+// Example: if constexpr (is_ascii_v<Header>) { /* byte-wise path */ }
+
+// True if every code unit is below 0x80
+CT_STRING_EXPORT template<ct_string S>
+inline constexpr bool is_ascii_v = ct_detail::is_ascii(S.c_str(), S.size());
+
+// True if S is well-formed in the encoding implied by its character type
+CT_STRING_EXPORT template<ct_string S>
+inline constexpr bool is_valid_encoding_v = ct_detail::is_valid_encoding(S.c_str(), S.size());
+
+// True if S is a byte string holding well-formed UTF-8
+CT_STRING_EXPORT template<ct_string S>
+inline constexpr bool is_valid_utf8_v =
+    sizeof(typename decltype(S)::value_type) == 1 && is_valid_encoding_v<S>;
+
+// True if S has an embedded '\0' (which truncates it when used through c_str())
+CT_STRING_EXPORT template<ct_string S>
+inline constexpr bool contains_nul_v = ct_detail::contains_nul(S.c_str(), S.size());
+
+// Number of Unicode code points in S. Requires well-formed input.
+CT_STRING_EXPORT template<ct_string S>
+    requires is_valid_encoding_v<S>
+inline constexpr std::size_t codepoint_count_v = ct_detail::codepoint_count(S.c_str(), S.size());
+
+// Number of terminal columns S occupies (wcswidth semantics, East Asian Wide and Fullwidth
+// characters take two columns, combining marks none). Control characters count as zero
+// columns rather than making the whole result invalid. Requires well-formed input.
+CT_STRING_EXPORT template<ct_string S>
+    requires is_valid_encoding_v<S>
+inline constexpr std::size_t display_width_v = ct_detail::display_width(S.c_str(), S.size());
+
+// --- Unicode normalization ---
+
+// Normalization forms of Unicode Standard Annex #15
+CT_STRING_EXPORT enum class normalization_form { nfc, nfd, nfkc, nfkd };
+
+namespace ct_detail {
+
+// ccc_table, decomposition_code_points, decomposition_nfd, decomposition_nfkd,
+// decomposition_pool and composition_table (char32_t literals, see the generator)
+#include "unicode_normalization_tables.inc"
+
+// Number of values in one of the tables above, without the literal's terminating '\0'
+template<std::size_t M>
+constexpr std::size_t table_size(const char32_t (&)[M]) {
+    return M - 1;
+}
+
+inline constexpr char32_t hangul_s_base = 0xAC00;
+inline constexpr char32_t hangul_l_base = 0x1100;
+inline constexpr char32_t hangul_v_base = 0x1161;
+inline constexpr char32_t hangul_t_base = 0x11A7;
+inline constexpr char32_t hangul_l_count = 19;
+inline constexpr char32_t hangul_v_count = 21;
+inline constexpr char32_t hangul_t_count = 28;
+inline constexpr char32_t hangul_s_count = hangul_l_count * hangul_v_count * hangul_t_count;
+
+constexpr unsigned combining_class(char32_t cp) {
+    if (cp < 0x300) {
+        return 0;
+    }
+    std::size_t lo = 0;
+    std::size_t hi = table_size(ccc_table) / 3;
+    while (lo < hi) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (cp < ccc_table[mid * 3]) {
+            hi = mid;
+        } else if (cp > ccc_table[mid * 3 + 1]) {
+            lo = mid + 1;
+        } else {
+            return static_cast<unsigned>(ccc_table[mid * 3 + 2]);
+        }
+    }
+    return 0;
+}
+
+// Appends the full canonical or compatibility decomposition of cp
+constexpr void decompose_into(char32_t cp, bool compat, std::vector<char32_t>& out) {
+    if (cp >= hangul_s_base && cp < hangul_s_base + hangul_s_count) {
+        const char32_t s_index = cp - hangul_s_base;
+        out.push_back(hangul_l_base + s_index / (hangul_v_count * hangul_t_count));
+        out.push_back(hangul_v_base + (s_index % (hangul_v_count * hangul_t_count)) / hangul_t_count);
+        if (s_index % hangul_t_count != 0) {
+            out.push_back(hangul_t_base + s_index % hangul_t_count);
+        }
+        return;
+    }
+    if (cp >= 0xA0) { // Nothing below U+00A0 decomposes
+        const char32_t* first = decomposition_code_points;
+        const char32_t* last = decomposition_code_points + table_size(decomposition_code_points);
+        const char32_t* it = std::lower_bound(first, last, cp);
+        if (it != last && *it == cp) {
+            const auto index = static_cast<std::size_t>(it - first);
+            const char32_t packed = compat ? decomposition_nfkd[index] : decomposition_nfd[index];
+            if (packed != 0) {
+                const std::size_t offset = packed >> 5;
+                const std::size_t length = packed & 0x1F;
+                out.insert(out.end(), decomposition_pool + offset, decomposition_pool + offset + length);
+                return;
+            }
+        }
+    }
+    out.push_back(cp);
+}
+
+// Primary composite of the pair, or 0 if the pair does not compose
+constexpr char32_t compose_pair(char32_t first, char32_t second) {
+    if (first >= hangul_l_base && first < hangul_l_base + hangul_l_count &&
+        second >= hangul_v_base && second < hangul_v_base + hangul_v_count) {
+        return hangul_s_base + ((first - hangul_l_base) * hangul_v_count + (second - hangul_v_base)) * hangul_t_count;
+    }
+    if (first >= hangul_s_base && first < hangul_s_base + hangul_s_count &&
+        (first - hangul_s_base) % hangul_t_count == 0 &&
+        second > hangul_t_base && second < hangul_t_base + hangul_t_count) {
+        return first + (second - hangul_t_base);
+    }
+    std::size_t lo = 0;
+    std::size_t hi = table_size(composition_table) / 3;
+    while (lo < hi) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        const char32_t mid_first = composition_table[mid * 3];
+        const char32_t mid_second = composition_table[mid * 3 + 1];
+        if (first < mid_first || (first == mid_first && second < mid_second)) {
+            hi = mid;
+        } else if (first > mid_first || second > mid_second) {
+            lo = mid + 1;
+        } else {
+            return composition_table[mid * 3 + 2];
+        }
+    }
+    return 0;
+}
+
+// Decodes, decomposes, canonically orders and (for NFC/NFKC) recomposes str.
+// Malformed code units become U+FFFD.
+template<typename CharT>
+constexpr std::vector<char32_t> normalize_code_points(const CharT* str, std::size_t n, normalization_form form) {
+    const bool compat = form == normalization_form::nfkc || form == normalization_form::nfkd;
+    const bool compose = form == normalization_form::nfc || form == normalization_form::nfkc;
+
+    std::vector<char32_t> cps;
+    cps.reserve(n);
+    for (std::size_t i = 0; i < n;) {
+        const char32_t cp = decode(str, n, i);
+        decompose_into(cp == invalid_code_point ? U'\xFFFD' : cp, compat, cps);
+    }
+
+    // Canonical ordering: stable insertion sort of each run of non-starters by combining class
+    for (std::size_t i = 1; i < cps.size(); ++i) {
+        const unsigned cc = combining_class(cps[i]);
+        if (cc == 0) {
+            continue;
+        }
+        for (std::size_t j = i; j > 0 && combining_class(cps[j - 1]) > cc; --j) {
+            std::swap(cps[j - 1], cps[j]);
+        }
+    }
+
+    if (!compose || cps.empty()) {
+        return cps;
+    }
+
+    // Canonical composition: combine each character with the last starter unless an
+    // intervening character of the same or higher combining class blocks it
+    std::size_t starter = 0;
+    std::size_t out = 1;
+    unsigned last_class = combining_class(cps[0]) == 0 ? 0 : 256;
+    for (std::size_t i = 1; i < cps.size(); ++i) {
+        const char32_t cp = cps[i];
+        const unsigned cc = combining_class(cp);
+        const char32_t composite = compose_pair(cps[starter], cp);
+        if (composite != 0 && (last_class < cc || last_class == 0)) {
+            cps[starter] = composite;
+            continue;
+        }
+        if (cc == 0) {
+            starter = out;
+        }
+        last_class = cc;
+        cps[out++] = cp;
+    }
+    cps.resize(out);
+    return cps;
+}
+
+template<normalization_form Form, ct_string S>
+constexpr auto normalize_ct() {
+    using char_type = typename decltype(S)::value_type;
+    static_assert(is_valid_encoding(S.c_str(), S.size()),
+                  "ct_string normalization: input is not well-formed UTF-8/UTF-16/UTF-32");
+    if constexpr (is_ascii(S.c_str(), S.size())) {
+        return S; // ASCII is invariant under every normalization form
+    } else {
+        constexpr std::size_t length = [] {
+            std::size_t len = 0;
+            for (const char32_t cp : normalize_code_points(S.c_str(), S.size(), Form)) {
+                len += encoded_units<char_type>(cp);
+            }
+            return len;
+        }();
+        ct_string<length, char_type> result{};
+        std::size_t o = 0;
+        for (const char32_t cp : normalize_code_points(S.c_str(), S.size(), Form)) {
+            encode(cp, result.data.data(), o);
+        }
+        return result;
+    }
+}
+
+} // namespace ct_detail
+
+// S in the given normalization form, stored in the same character type. Evaluated once per
+// (Form, S) at compile time using the tables in unicode_normalization_tables.inc.
+CT_STRING_EXPORT template<normalization_form Form, ct_string S>
+inline constexpr auto normalized_v = ct_detail::normalize_ct<Form, S>();
+
+// Example: constexpr auto name = to_nfc<"Zoë">(); // "Zoë" with a precomposed U+00EB
+CT_STRING_EXPORT template<ct_string S>
+constexpr auto to_nfc() {
+    return normalized_v<normalization_form::nfc, S>;
+}
+
+CT_STRING_EXPORT template<ct_string S>
+constexpr auto to_nfd() {
+    return normalized_v<normalization_form::nfd, S>;
+}
+
+CT_STRING_EXPORT template<ct_string S>
+constexpr auto to_nfkc() {
+    return normalized_v<normalization_form::nfkc, S>;
+}
+
+CT_STRING_EXPORT template<ct_string S>
+constexpr auto to_nfkd() {
+    return normalized_v<normalization_form::nfkd, S>;
+}
+
+// Normalizes runtime input with the same tables, for the dynamic side of a comparison against
+// a pre-normalized constant. ASCII input is returned unchanged without table lookups, and
+// malformed code units are replaced with U+FFFD.
+CT_STRING_EXPORT template<ct_char CharT>
+std::basic_string<CharT> normalize(std::basic_string_view<CharT> input, normalization_form form) {
+    if (ct_detail::is_ascii(input.data(), input.size())) {
+        return std::basic_string<CharT>(input);
+    }
+    const std::vector<char32_t> cps = ct_detail::normalize_code_points(input.data(), input.size(), form);
+    std::size_t length = 0;
+    for (const char32_t cp : cps) {
+        length += ct_detail::encoded_units<CharT>(cp);
+    }
+    std::basic_string<CharT> result(length, CharT{});
+    std::size_t o = 0;
+    for (const char32_t cp : cps) {
+        ct_detail::encode(cp, result.data(), o);
+    }
+    return result;
+}
@@ -0,0 +1,19 @@
+module;
+
+#include <array>
+#include <cstddef>
+#include <cstdint>     // For fixed-width code unit types
+#include <algorithm>   // For std::sort, std::upper_bound
+#include <string>      // For normalize()
+#include <string_view>
+#include <type_traits>
+#include <vector>      // For transient storage in constexpr normalization
+
+#define CT_STRING_MODULE_INTERFACE
+
+export module ct_string.unicode;
+
+export import ct_string.core;
+
+// ct_string.unicode.hpp with its public declarations exported
+#include "ct_string.unicode.hpp"
@@ -0,0 +1,331 @@
+#pragma once
+
+// io_uring fixed buffers for constant payloads (Linux). fixed_payloads lays out a set of
+// ct_string constants (banners, canned responses, protocol preambles) in one static block,
+// each starting on its own page, and registers them with a ring as fixed buffers. Writes of a
+// payload then use IORING_OP_WRITE_FIXED: the kernel pinned its pages once at registration
+// and does not map or pin them again per operation. uring_queue is the minimal ring this
+// needs, driven through the kernel interface directly so liburing is not required.
+
+#include "ct_string.config.hpp"
+
+#ifndef CT_STRING_MODULE_INTERFACE
+#include "ct_string.core.hpp"
+#include <array>
+#include <atomic>       // For std::atomic_ref on the shared ring indices
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>     // For mapping the rings
+#include <sys/syscall.h>  // For the io_uring system call numbers
+#include <sys/uio.h>      // For struct iovec
+#include <unistd.h>
+#endif
+#endif
+
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+
+// --- Ring ---
+
+// A single-threaded io_uring instance: prepare operations, submit() them, reap() completions.
+// Failures are reported like system calls, false or -1 with errno set.
+CT_STRING_EXPORT class uring_queue {
+public:
+    // entries is rounded up to a power of two by the kernel. valid() tells whether setup worked.
+    explicit uring_queue(unsigned entries = 64) {
+        io_uring_params params{};
+        const long fd = ::syscall(__NR_io_uring_setup, entries, &params);
+        if (fd < 0) {
+            error_ = errno;
+            return;
+        }
+        fd_ = static_cast<int>(fd);
+        sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            sq_ring_size_ = cq_ring_size_ = sq_ring_size_ > cq_ring_size_ ? sq_ring_size_ : cq_ring_size_;
+        }
+        sq_ring_ = map(sq_ring_size_, IORING_OFF_SQ_RING);
+        cq_ring_ = single_mmap ? sq_ring_ : map(cq_ring_size_, IORING_OFF_CQ_RING);
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqes_size_, IORING_OFF_SQES));
+        if (sq_ring_ == nullptr || cq_ring_ == nullptr || sqes_ == nullptr) {
+            error_ = errno;
+            release();
+            return;
+        }
+        char* sq = static_cast<char*>(sq_ring_);
+        char* cq = static_cast<char*>(cq_ring_);
+        sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_entries_ = params.sq_entries;
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    }
+
+    ~uring_queue() { release(); }
+
+    uring_queue(const uring_queue&) = delete;
+    uring_queue& operator=(const uring_queue&) = delete;
+
+    bool valid() const { return fd_ >= 0; }
+    // The errno of a failed setup
+    int error() const { return error_; }
+    int fd() const { return fd_; }
+
+    // Registers the buffers fixed writes may use, indexed in the order given. A ring has one
+    // such table at a time; unregister_buffers() drops it.
+    bool register_buffers(std::span<const struct iovec> buffers) {
+        return ::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, buffers.data(),
+                         static_cast<unsigned>(buffers.size())) == 0;
+    }
+
+    bool unregister_buffers() {
+        return ::syscall(__NR_io_uring_register, fd_, IORING_UNREGISTER_BUFFERS, nullptr, 0) == 0;
+    }
+
+    // Queues a write of data[0..size) from registered buffer buffer_index, which must contain
+    // it. offset is the file position, or -1 for the current one (pipes and sockets). Returns
+    // false with errno EBUSY if the submission queue is full.
+    bool prepare_write_fixed(int fd, const void* data, std::uint32_t size, std::uint16_t buffer_index,
+                             std::uint64_t user_data, std::uint64_t offset = ~std::uint64_t{0}) {
+        io_uring_sqe* sqe = next_sqe();
+        if (sqe == nullptr) {
+            return false;
+        }
+        sqe->opcode = IORING_OP_WRITE_FIXED;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<std::uint64_t>(data);
+        sqe->len = size;
+        sqe->off = offset;
+        sqe->buf_index = buffer_index;
+        sqe->user_data = user_data;
+        return true;
+    }
+
+    // The same from any memory, which the kernel maps for the duration of the operation
+    bool prepare_write(int fd, const void* data, std::uint32_t size, std::uint64_t user_data,
+                       std::uint64_t offset = ~std::uint64_t{0}) {
+        io_uring_sqe* sqe = next_sqe();
+        if (sqe == nullptr) {
+            return false;
+        }
+        sqe->opcode = IORING_OP_WRITE;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<std::uint64_t>(data);
+        sqe->len = size;
+        sqe->off = offset;
+        sqe->user_data = user_data;
+        return true;
+    }
+
+    // Passes the prepared operations to the kernel and waits until at least wait_for have
+    // completed. Returns the number submitted, or -1 with errno set.
+    int submit(unsigned wait_for = 0) {
+        const unsigned pending = prepared_;
+        for (;;) {
+            const long submitted = ::syscall(__NR_io_uring_enter, fd_, pending, wait_for,
+                                             wait_for > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+            if (submitted >= 0) {
+                prepared_ -= static_cast<unsigned>(submitted);
+                return static_cast<int>(submitted);
+            }
+            if (errno != EINTR) {
+                return -1;
+            }
+        }
+    }
+
+    // Calls visit(user_data, result) for each completion, where result is the operation's
+    // return value (bytes written, or -errno). Returns the number of completions.
+    template<typename Visitor>
+    unsigned reap(Visitor&& visit) {
+        unsigned head = *cq_head_;
+        const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+        unsigned count = 0;
+        for (; head != tail; ++head, ++count) {
+            const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+            visit(static_cast<std::uint64_t>(cqe.user_data), static_cast<int>(cqe.res));
+        }
+        std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+        return count;
+    }
+
+private:
+    void* map(std::size_t size, off_t offset) {
+        void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+        return address == MAP_FAILED ? nullptr : address;
+    }
+
+    io_uring_sqe* next_sqe() {
+        const unsigned tail = *sq_tail_;
+        if (tail - std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire) >= sq_entries_) {
+            errno = EBUSY;
+            return nullptr;
+        }
+        const unsigned index = tail & sq_mask_;
+        io_uring_sqe* sqe = &sqes_[index];
+        *sqe = io_uring_sqe{};
+        sq_array_[index] = index;
+        std::atomic_ref<unsigned>(*sq_tail_).store(tail + 1, std::memory_order_release);
+        ++prepared_;
+        return sqe;
+    }
+
+    void release() {
+        if (sqes_ != nullptr) {
+            ::munmap(sqes_, sqes_size_);
+        }
+        if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+            ::munmap(cq_ring_, cq_ring_size_);
+        }
+        if (sq_ring_ != nullptr) {
+            ::munmap(sq_ring_, sq_ring_size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        sqes_ = nullptr;
+        sq_ring_ = cq_ring_ = nullptr;
+        fd_ = -1;
+    }
+
+    int fd_ = -1;
+    int error_ = 0;
+    void* sq_ring_ = nullptr;
+    void* cq_ring_ = nullptr;
+    io_uring_sqe* sqes_ = nullptr;
+    std::size_t sq_ring_size_ = 0;
+    std::size_t cq_ring_size_ = 0;
+    std::size_t sqes_size_ = 0;
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned prepared_ = 0;
+};
+
+// --- Fixed payloads ---
+
+// Page size the payloads are aligned to; larger pages only mean payloads may share one
+CT_STRING_EXPORT inline constexpr std::size_t fixed_payload_alignment = 4096;
+
+// A set of constant payloads in one static block, each page-aligned, registered with a ring
+// as fixed buffers 0, 1, ... in the order given:
+//   using canned = fixed_payloads<not_found_response, busy_response>;
+//   canned::register_with(ring);
+//   canned::prepare_write<not_found_response>(ring, client_fd, user_data);
+// The block is writable static data, initialized at compile time: the kernel pins registered
+// pages for writing, which it refuses for read-only data.
+CT_STRING_EXPORT template<ct_string... Payloads>
+class fixed_payloads {
+    static_assert(sizeof...(Payloads) > 0, "fixed_payloads: at least one payload is required");
+    static_assert(sizeof...(Payloads) <= 65536, "fixed_payloads: buffer indices are 16-bit");
+    static_assert(((Payloads.size() > 0) && ...), "fixed_payloads: payloads must not be empty");
+    static_assert(((Payloads.size() <= 0xFFFFFFFFu) && ...), "fixed_payloads: a write is at most 4 GiB");
+    static_assert((std::is_same_v<typename decltype(Payloads)::value_type, char> && ...),
+                  "fixed_payloads: payloads must be char strings");
+
+    static constexpr std::size_t count = sizeof...(Payloads);
+    static constexpr std::size_t sizes[count] = {Payloads.size()...};
+
+    static constexpr std::size_t round_up(std::size_t n) {
+        return (n + fixed_payload_alignment - 1) / fixed_payload_alignment * fixed_payload_alignment;
+    }
+
+    static constexpr std::array<std::size_t, count + 1> offsets = [] {
+        std::array<std::size_t, count + 1> out{};
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i + 1] = out[i] + round_up(sizes[i]);
+        }
+        return out;
+    }();
+
+    struct alignas(fixed_payload_alignment) block {
+        char bytes[offsets[count]];
+    };
+
+    static constexpr block build() {
+        block out{};
+        std::size_t index = 0;
+        const auto place = [&out, &index](const auto& payload) {
+            char* to = out.bytes + offsets[index++];
+            for (std::size_t start = 0; start < payload.size(); start += ct_detail::constexpr_block) {
+                const std::size_t end = ct_detail::block_end(start, payload.size());
+                for (std::size_t i = start; i < end; ++i) {
+                    to[i] = payload.data[i];
+                }
+            }
+        };
+        (place(Payloads), ...);
+        return out;
+    }
+
+    constinit static inline block storage = build();
+
+    template<ct_string S>
+    static constexpr std::size_t find() {
+        constexpr std::string_view texts[count] = {std::string_view(Payloads)...};
+        for (std::size_t i = 0; i < count; ++i) {
+            if (texts[i] == std::string_view(S)) {
+                return i;
+            }
+        }
+        return count;
+    }
+
+public:
+    static constexpr std::size_t size() { return count; }
+
+    // The registered buffer index of payload S
+    template<ct_string S>
+    static constexpr std::uint16_t index_of() {
+        constexpr std::size_t index = find<S>();
+        static_assert(index < count, "fixed_payloads: S is not one of the payloads");
+        return static_cast<std::uint16_t>(index);
+    }
+
+    // Payload i where it is stored
+    static std::string_view payload(std::size_t i) { return {storage.bytes + offsets[i], sizes[i]}; }
+
+    static std::array<struct iovec, count> iovecs() {
+        std::array<struct iovec, count> out{};
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = {storage.bytes + offsets[i], sizes[i]};
+        }
+        return out;
+    }
+
+    // Registers the payloads as the ring's fixed buffers
+    static bool register_with(uring_queue& ring) {
+        const auto buffers = iovecs();
+        return ring.register_buffers(buffers);
+    }
+
+    // Queues a fixed write of payload S; see uring_queue::prepare_write_fixed. As with write(),
+    // a pipe or socket may take fewer bytes than the payload; the completion says how many.
+    template<ct_string S>
+    static bool prepare_write(uring_queue& ring, int fd, std::uint64_t user_data,
+                              std::uint64_t offset = ~std::uint64_t{0}) {
+        constexpr std::uint16_t index = index_of<S>();
+        return ring.prepare_write_fixed(fd, storage.bytes + offsets[index], static_cast<std::uint32_t>(sizes[index]),
+                                        index, user_data, offset);
+    }
+};
+
+#endif
@@ -0,0 +1,26 @@
+module;
+
+#include <array>
+#include <atomic>       // For std::atomic_ref on the shared ring indices
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>     // For mapping the rings
+#include <sys/syscall.h>  // For the io_uring system call numbers
+#include <sys/uio.h>      // For struct iovec
+#include <unistd.h>
+#endif
+
+#define CT_STRING_MODULE_INTERFACE
+
+export module ct_string.uring;
+
+export import ct_string.core;
+
+// ct_string.uring.hpp with its public declarations exported
+#include "ct_string.uring.hpp"
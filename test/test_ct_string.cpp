@@ -5,9 +5,26 @@
 #include <cstring>   // For strcmp
 #include <algorithm> // For std::equal with iterators
 #include <array>     // For iterator test accumulation
-
-// Ensure this import matches your module setup
+#include <type_traits> // For std::is_same_v
+#include <compare>   // For std::strong_ordering
+#include <cstdint>   // For fixed-width integer types
+#include <limits>    // For std::numeric_limits
+#include <cmath>     // For std::isnan, std::isinf
+#include <charconv>  // For std::to_chars reference results
+#include <cstddef>   // For std::byte
+#include <sstream>   // For stream output
+#include <unordered_set> // For std::hash lookups
+#include <functional>    // For std::hash
+#include <optional>      // try_parse_* results
+#include <source_location> // ct_here() is evaluated at the call site
+#include "embedded_sample.hpp" // Generated by ct_string_embed() from data/embedded_sample.txt
+
+// CT_STRING_HEADER_ONLY is set by the ct_string CMake target when modules are off
+#ifdef CT_STRING_HEADER_ONLY
+#include <ct_string/ct_string.hpp>
+#else
 import ct_string;
+#endif
 
 TEST_CASE("ct_string Construction", "[ct_string][construction]") {
     SECTION("Default constructor (empty string)") {
@@ -276,4 +293,660 @@ TEST_CASE("ct_string Iterators", "[ct_string][iterators]") {
         constexpr std::array<char, 0> empty_iterated_chars = accumulate_chars_compile_time(ct_string<>(""));
         STATIC_REQUIRE(empty_iterated_chars.empty());
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("ct_string Character Types", "[ct_string][char_types]") {
+    SECTION("Deduction from prefixed literals") {
+        constexpr ct_string u8s = u8"Grüße";
+        constexpr ct_string u16s = u"Grüße";
+        constexpr ct_string u32s = U"Grüße";
+        constexpr ct_string ws = L"Grüße";
+
+        STATIC_REQUIRE(std::is_same_v<decltype(u8s)::value_type, char8_t>);
+        STATIC_REQUIRE(std::is_same_v<decltype(u16s)::value_type, char16_t>);
+        STATIC_REQUIRE(std::is_same_v<decltype(u32s)::value_type, char32_t>);
+        STATIC_REQUIRE(std::is_same_v<decltype(ws)::value_type, wchar_t>);
+
+        STATIC_REQUIRE(u8s.size() == 7); // 'ü' and 'ß' are two UTF-8 code units each
+        STATIC_REQUIRE(u16s.size() == 5);
+        STATIC_REQUIRE(u32s.size() == 5);
+        STATIC_REQUIRE(u16s[2] == u'ü');
+    }
+
+    SECTION("Aliases name the same types") {
+        STATIC_REQUIRE(std::is_same_v<ct_string<3>, basic_ct_string<char, 3>>);
+        STATIC_REQUIRE(std::is_same_v<u8ct_string<3>, basic_ct_string<char8_t, 3>>);
+        STATIC_REQUIRE(std::is_same_v<u16ct_string<3>, ct_string<3, char16_t>>);
+        STATIC_REQUIRE(std::is_same_v<u32ct_string<3>, ct_string<3, char32_t>>);
+        STATIC_REQUIRE(std::is_same_v<wct_string<3>, ct_string<3, wchar_t>>);
+
+        constexpr u16ct_string<2> explicit_u16(u"ab");
+        STATIC_REQUIRE(explicit_u16 == u"ab");
+    }
+
+    SECTION("Conversions, concatenation and comparison") {
+        constexpr ct_string hello = u"Hello, ";
+        constexpr ct_string world = u"World";
+        constexpr auto joined = hello + world;
+        STATIC_REQUIRE(joined.size() == 12);
+        STATIC_REQUIRE(std::u16string_view(joined) == u"Hello, World");
+        STATIC_REQUIRE(joined == std::u16string_view(u"Hello, World"));
+        STATIC_REQUIRE(u"Hello, World" == joined);
+        STATIC_REQUIRE(joined != nullptr);
+        STATIC_REQUIRE((hello <=> world) == std::strong_ordering::less);
+        STATIC_REQUIRE((U"abc" <=> ct_string(U"abd")) == std::strong_ordering::less);
+
+        std::u32string owned = ct_string(U"Grüße");
+        REQUIRE(owned == U"Grüße");
+
+        static constexpr ct_string wide = L"wide";
+        const wchar_t* wptr = wide;
+        REQUIRE(std::wstring_view(wptr) == L"wide");
+    }
+}
+
+TEST_CASE("ct_string Unicode Transcoding", "[ct_string][unicode]") {
+    SECTION("UTF-8 to UTF-16 and UTF-32") {
+        constexpr auto u16 = to_utf16<"Grüße">();
+        STATIC_REQUIRE(std::is_same_v<decltype(u16), const ct_string<5, char16_t>>);
+        STATIC_REQUIRE(u16 == u"Grüße");
+
+        constexpr auto u32 = to_utf32<u8"€ 😀">();
+        STATIC_REQUIRE(u32.size() == 3);
+        STATIC_REQUIRE(u32 == U"€ 😀");
+    }
+
+    SECTION("Surrogate pairs") {
+        constexpr auto u16 = to_utf16<U"a😀b">();
+        STATIC_REQUIRE(u16.size() == 4);
+        STATIC_REQUIRE(u16[1] == 0xD83D);
+        STATIC_REQUIRE(u16[2] == 0xDE00);
+        STATIC_REQUIRE(to_utf32<u"a😀b">() == U"a😀b");
+    }
+
+    SECTION("Back to UTF-8") {
+        constexpr auto u8 = to_utf8<U"Grüße 😀">();
+        STATIC_REQUIRE(u8.size() == 12);
+        STATIC_REQUIRE(u8 == u8"Grüße 😀");
+        STATIC_REQUIRE(to_utf8<u"Grüße 😀">() == u8"Grüße 😀");
+        STATIC_REQUIRE(to_utf8<L"wide">() == u8"wide");
+    }
+
+    SECTION("Round trips and empty input") {
+        STATIC_REQUIRE(to_utf8<to_utf16<"日本語">()>() == u8"日本語");
+        STATIC_REQUIRE(to_utf16<"">().empty());
+    }
+    // Malformed input such as to_utf16<"\xC0\xAF">() (overlong '/') fails to compile.
+}
+
+TEST_CASE("ct_string Text Properties", "[ct_string][unicode][properties]") {
+    SECTION("is_ascii_v") {
+        STATIC_REQUIRE(is_ascii_v<"Content-Length">);
+        STATIC_REQUIRE(is_ascii_v<"">);
+        STATIC_REQUIRE_FALSE(is_ascii_v<"Grüße">);
+        STATIC_REQUIRE(is_ascii_v<u"plain">);
+        STATIC_REQUIRE_FALSE(is_ascii_v<U"日本">);
+    }
+
+    SECTION("is_valid_utf8_v and is_valid_encoding_v") {
+        STATIC_REQUIRE(is_valid_utf8_v<"Grüße 😀">);
+        STATIC_REQUIRE(is_valid_utf8_v<u8"€">);
+        STATIC_REQUIRE_FALSE(is_valid_utf8_v<"\xC0\xAF">);   // Overlong '/'
+        STATIC_REQUIRE_FALSE(is_valid_utf8_v<"\xED\xA0\x80">); // Encoded surrogate
+        STATIC_REQUIRE_FALSE(is_valid_utf8_v<"\xE2\x82">);   // Truncated sequence
+        STATIC_REQUIRE_FALSE(is_valid_utf8_v<u"utf16">);      // Not a byte string
+        STATIC_REQUIRE(is_valid_encoding_v<u"utf16 😀">);
+        STATIC_REQUIRE_FALSE(is_valid_encoding_v<u"\xD800">);
+    }
+
+    SECTION("contains_nul_v") {
+        STATIC_REQUIRE_FALSE(contains_nul_v<"abc">);
+        STATIC_REQUIRE(contains_nul_v<"a\0c">);
+    }
+
+    SECTION("codepoint_count_v") {
+        STATIC_REQUIRE(codepoint_count_v<"Grüße"> == 5);
+        STATIC_REQUIRE(codepoint_count_v<u"a😀b"> == 3);
+        STATIC_REQUIRE(codepoint_count_v<U"a😀b"> == 3);
+        STATIC_REQUIRE(codepoint_count_v<""> == 0);
+    }
+
+    SECTION("display_width_v") {
+        STATIC_REQUIRE(display_width_v<"Name"> == 4);
+        STATIC_REQUIRE(display_width_v<"名前"> == 4);       // Wide CJK
+        STATIC_REQUIRE(display_width_v<"ｶﾀｶﾅ"> == 4);       // Halfwidth katakana
+        STATIC_REQUIRE(display_width_v<"Ｆｕｌｌ"> == 8);   // Fullwidth Latin
+        STATIC_REQUIRE(display_width_v<"é"> == 1);  // Combining acute accent
+        STATIC_REQUIRE(display_width_v<"😀!"> == 3);
+        STATIC_REQUIRE(display_width_v<"a\tb"> == 2);     // Controls take no columns
+    }
+}
+
+TEST_CASE("ct_string Case Folding", "[ct_string][case]") {
+    SECTION("to_lower and to_upper") {
+        STATIC_REQUIRE(to_lower<"Content-Type: TEXT/html">() == "content-type: text/html");
+        STATIC_REQUIRE(to_upper<"select * from t1">() == "SELECT * FROM T1");
+        STATIC_REQUIRE(to_upper<u"Grüße">() == u"GRüßE"); // ASCII letters only
+        STATIC_REQUIRE(to_lower<"">().empty());
+    }
+
+    SECTION("iequals at compile time") {
+        STATIC_REQUIRE(iequals<"Content-Length">("content-length"));
+        STATIC_REQUIRE(iequals<"Content-Length">("CONTENT-LENGTH"));
+        STATIC_REQUIRE_FALSE(iequals<"Content-Length">("Content_Length"));
+        STATIC_REQUIRE_FALSE(iequals<"Content-Length">("Content-Lengt"));
+        STATIC_REQUIRE(iequals<u"Select">(u"sELECT"));
+        STATIC_REQUIRE(iequals<"">(""));
+    }
+
+    SECTION("iequals at runtime") {
+        // Lengths around the 8-byte word boundary
+        std::string input = "ACCEPT-ENCODING";
+        REQUIRE(iequals<"Accept-Encoding">(input));
+        REQUIRE(iequals<"accept-encoding">(input));
+        input[14] = 'H';
+        REQUIRE_FALSE(iequals<"Accept-Encoding">(input));
+        REQUIRE(iequals<"Host">(std::string("hOsT")));
+        REQUIRE(iequals<"x-request-id">(std::string("X-Request-ID")));
+        // Non-letters never match their 0x20-shifted counterparts
+        REQUIRE_FALSE(iequals<"a@b[c]d{e}f">(std::string("a`b{c}d[e]f")));
+        REQUIRE_FALSE(iequals<"12345678-">(std::string("12345678\r")));
+    }
+
+    SECTION("ci_perfect_hash") {
+        using methods = ci_perfect_hash<"GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH">;
+        STATIC_REQUIRE(methods::size == 9);
+        STATIC_REQUIRE(methods::find("GET") == 0);
+        STATIC_REQUIRE(methods::find("patch") == 8);
+        STATIC_REQUIRE(methods::find("GETS") == methods::npos);
+        STATIC_REQUIRE_FALSE(methods::contains(""));
+
+        using single = ci_perfect_hash<"only">;
+        STATIC_REQUIRE(single::find("ONLY") == 0);
+        STATIC_REQUIRE(single::find("once") == single::npos);
+
+        using keywords = ci_perfect_hash<"SELECT", "FROM", "WHERE", "GROUP", "BY", "ORDER", "HAVING", "LIMIT",
+                                         "OFFSET", "JOIN", "INNER", "LEFT", "RIGHT", "OUTER", "ON", "AS", "AND",
+                                         "OR", "NOT", "NULL", "IS", "IN", "LIKE", "BETWEEN", "UNION", "ALL",
+                                         "DISTINCT", "INSERT", "INTO", "VALUES", "UPDATE", "SET", "DELETE">;
+        const std::string words[] = {"select", "From", "wHeRe", "distinct", "delete", "Null", "by"};
+        const std::size_t expected[] = {0, 1, 2, 26, 32, 19, 4};
+        for (std::size_t i = 0; i < 7; ++i) {
+            REQUIRE(keywords::find(words[i]) == expected[i]);
+        }
+        REQUIRE(keywords::find(std::string("selects")) == keywords::npos);
+        REQUIRE(keywords::find(std::string("fro")) == keywords::npos);
+        REQUIRE_FALSE(keywords::contains(std::string("TABLE")));
+    }
+}
+
+TEST_CASE("ct_string Unicode Normalization", "[ct_string][unicode][normalization]") {
+    SECTION("NFC composes, NFD decomposes") {
+        // "Zoë" spelled with a combining diaeresis (U+0308)
+        STATIC_REQUIRE(to_nfc<u"Zoe\u0308">() == u"Zo\u00EB");
+        STATIC_REQUIRE(to_nfd<u"Zo\u00EB">() == u"Zoe\u0308");
+        STATIC_REQUIRE(to_nfc<U"\u1E0B\u0323">() == U"\u1E0D\u0307"); // Reordered, then recomposed
+        STATIC_REQUIRE(to_nfd<U"\u1E0B\u0323">() == U"d\u0323\u0307");
+        STATIC_REQUIRE(to_nfc<U"\u212B">() == U"\u00C5");  // Angstrom sign is a singleton decomposition
+        STATIC_REQUIRE(to_nfc<U"\u0344">() == U"\u0308\u0301"); // Composition exclusion
+        STATIC_REQUIRE(to_nfc<u8"e\u0301">() == u8"\u00E9");
+        STATIC_REQUIRE(to_nfc<u8"e\u0301">().size() == 2);
+    }
+
+    SECTION("Hangul") {
+        STATIC_REQUIRE(to_nfd<U"\uD55C">() == U"\u1112\u1161\u11AB");
+        STATIC_REQUIRE(to_nfc<U"\u1112\u1161\u11AB">() == U"\uD55C");
+        STATIC_REQUIRE(to_nfc<U"\u1100\u1161">() == U"\uAC00");
+    }
+
+    SECTION("Compatibility forms") {
+        STATIC_REQUIRE(to_nfkc<U"\uFB01le">() == U"file");       // Ligature
+        STATIC_REQUIRE(to_nfkc<U"\uFF21\uFF22\uFF23">() == U"ABC"); // Fullwidth
+        STATIC_REQUIRE(to_nfkc<U"x\u00B2">() == U"x2");
+        STATIC_REQUIRE(to_nfkd<U"\u1E9B\u0323">() == U"s\u0323\u0307");
+        STATIC_REQUIRE(to_nfkc<U"\u1E9B\u0323">() == U"\u1E69");
+        STATIC_REQUIRE(to_nfc<U"\uFB01">() == U"\uFB01"); // Canonical forms keep the ligature
+    }
+
+    SECTION("ASCII is returned unchanged") {
+        STATIC_REQUIRE(to_nfkc<"plain ascii">() == "plain ascii");
+        STATIC_REQUIRE(to_nfc<"">().empty());
+    }
+
+    SECTION("Runtime normalization matches compile-time results") {
+        static constexpr auto constant = to_nfc<u8"Cafe\u0301 \uFF21">();
+        const std::u8string dynamic = u8"Cafe\u0301 \uFF21";
+        REQUIRE(normalize(std::u8string_view(dynamic), normalization_form::nfc) == std::u8string_view(constant));
+        REQUIRE(normalize(std::u8string_view(dynamic), normalization_form::nfkc) == u8"Caf\u00E9 A");
+        REQUIRE(normalize(std::string_view("ascii"), normalization_form::nfd) == "ascii");
+        REQUIRE(normalize(std::string_view("bad \xFF"), normalization_form::nfc) == "bad \xEF\xBF\xBD");
+    }
+}
+
+TEST_CASE("ct_string Numeric Parsing", "[ct_string][parse]") {
+    SECTION("parse_int") {
+        STATIC_REQUIRE(parse_int<"42">() == 42);
+        STATIC_REQUIRE(parse_int<"-17">() == -17);
+        STATIC_REQUIRE(parse_int<"0">() == 0);
+        STATIC_REQUIRE(parse_int<"-9223372036854775808">() == std::numeric_limits<long long>::min());
+        STATIC_REQUIRE(parse_int<"-80", 16, std::int8_t>() == -128);
+        STATIC_REQUIRE(std::is_same_v<decltype(parse_int<"1", 10, int>()), int>);
+    }
+
+    SECTION("parse_uint") {
+        STATIC_REQUIRE(parse_uint<"8080">() == 8080);
+        STATIC_REQUIRE(parse_uint<"DeadBeef", 16>() == 0xDEADBEEF);
+        STATIC_REQUIRE(parse_uint<"ff00", 16, std::uint16_t>() == 0xFF00);
+        STATIC_REQUIRE(parse_uint<"101", 2>() == 5);
+        STATIC_REQUIRE(parse_uint<"zz", 36>() == 1295);
+        STATIC_REQUIRE(parse_uint<"18446744073709551615">() == std::numeric_limits<unsigned long long>::max());
+        // parse_uint<"-1">(), parse_uint<"256", 10, std::uint8_t>(), parse_int<"+1">() and
+        // parse_int<" 1">() are rejected at compile time, as std::from_chars rejects them.
+    }
+
+    SECTION("parse_double") {
+        STATIC_REQUIRE(parse_double<"0.1">() == 0.1);
+        STATIC_REQUIRE(parse_double<"-2.5e-3">() == -2.5e-3);
+        STATIC_REQUIRE(parse_double<"1e308">() == 1e308);
+        STATIC_REQUIRE(parse_double<"1.7976931348623157e308">() == std::numeric_limits<double>::max());
+        STATIC_REQUIRE(parse_double<"4.9406564584124654e-324">() == std::numeric_limits<double>::denorm_min());
+        STATIC_REQUIRE(parse_double<"2.2250738585072014e-308">() == std::numeric_limits<double>::min());
+        STATIC_REQUIRE(parse_double<"1e-400">() == 0.0);
+        STATIC_REQUIRE(parse_double<".5">() == 0.5);
+        STATIC_REQUIRE(parse_double<"5.">() == 5.0);
+        STATIC_REQUIRE(parse_double<"00012.3400E+2">() == 1234.0);
+        STATIC_REQUIRE(parse_double<"3.14159265358979323846264338327950288">() == 3.141592653589793);
+        // Exactly halfway between 1 and the next double: rounds to even
+        STATIC_REQUIRE(parse_double<"1.00000000000000011102230246251565404236316680908203125">() == 1.0);
+        STATIC_REQUIRE(parse_double<"1.00000000000000011102230246251565404236316680908203126">() > 1.0);
+        STATIC_REQUIRE(parse_double<"-Infinity">() == -std::numeric_limits<double>::infinity());
+        REQUIRE(std::isnan(parse_double<"nan(ind)">()));
+    }
+
+    SECTION("Runtime parsers accept the same grammar") {
+        REQUIRE(try_parse_int<int>(std::string("-17")) == -17);
+        REQUIRE(try_parse_int<std::uint16_t>(std::string("ff00"), 16) == 0xFF00);
+        REQUIRE_FALSE(try_parse_int<unsigned>(std::string("-1")));
+        REQUIRE_FALSE(try_parse_int<int>(std::string("+1")));
+        REQUIRE_FALSE(try_parse_int<int>(std::string("12abc")));
+        REQUIRE_FALSE(try_parse_int<std::uint8_t>(std::string("256")));
+        REQUIRE_FALSE(try_parse_int<int>(std::string("10"), 1));
+        REQUIRE_FALSE(try_parse_int<int>(std::string("10"), 40));
+        REQUIRE_FALSE(try_parse_int<int>(std::string("0"), 0));
+        REQUIRE(try_parse_int<int>(std::string("z"), 36) == 35);
+
+        REQUIRE(try_parse_double(std::string("0.1")) == parse_double<"0.1">());
+        REQUIRE(try_parse_double(std::string("00012.3400E+2")) == parse_double<"00012.3400E+2">());
+        REQUIRE(try_parse_double(std::string(".5")) == 0.5);
+        REQUIRE_FALSE(try_parse_double(std::string("1e")));
+        REQUIRE_FALSE(try_parse_double(std::string("+1")));
+        REQUIRE_FALSE(try_parse_double(std::string(" 1")));
+    }
+
+    SECTION("Runtime and compile-time parsers agree at the ends of the range") {
+        // Same value and same sign, so underflow to -0.0 is told apart from 0.0
+        const auto same = [](double expected, std::optional<double> runtime) {
+            return runtime && *runtime == expected && std::signbit(*runtime) == std::signbit(expected);
+        };
+        // Underflow rounds to zero
+        REQUIRE(same(parse_double<"1e-400">(), try_parse_double(std::string("1e-400"))));
+        REQUIRE(same(parse_double<"-1e-400">(), try_parse_double(std::string("-1e-400"))));
+        REQUIRE(same(parse_double<"2.4e-324">(), try_parse_double(std::string("2.4e-324"))));
+        REQUIRE(same(parse_double<"1e-99999999999">(), try_parse_double(std::string("1e-99999999999"))));
+        REQUIRE(std::signbit(parse_double<"-1e-400">()));
+        // Subnormals, including the halfway case that rounds up to the smallest one
+        REQUIRE(same(parse_double<"2.5e-324">(), try_parse_double(std::string("2.5e-324"))));
+        REQUIRE(same(parse_double<"4.9406564584124654e-324">(), try_parse_double(std::string("4.9406564584124654e-324"))));
+        REQUIRE(same(parse_double<"1e-320">(), try_parse_double(std::string("1e-320"))));
+        REQUIRE(same(parse_double<"2.2250738585072011e-308">(), try_parse_double(std::string("2.2250738585072011e-308"))));
+        // The largest finite values parse; beyond them parse_double<> fails to compile and the
+        // runtime parser returns nullopt
+        REQUIRE(same(parse_double<"1.7976931348623157e308">(), try_parse_double(std::string("1.7976931348623157e308"))));
+        REQUIRE(same(parse_double<"1.7976931348623158e308">(), try_parse_double(std::string("1.7976931348623158e308"))));
+        REQUIRE_FALSE(try_parse_double(std::string("1.7976931348623159e308")));
+        REQUIRE_FALSE(try_parse_double(std::string("1e309")));
+        REQUIRE_FALSE(try_parse_double(std::string("-1e309")));
+        REQUIRE_FALSE(try_parse_double(std::string("1e-400x")));
+    }
+}
+
+TEST_CASE("ct_string Floating-Point Formatting", "[ct_string][format]") {
+    SECTION("Shortest round-trip digits") {
+        STATIC_REQUIRE(to_ct_string<0.3>() == "0.3");
+        STATIC_REQUIRE(to_ct_string<0.1 + 0.2>() == "0.30000000000000004");
+        STATIC_REQUIRE(to_ct_string<1.0>() == "1");
+        STATIC_REQUIRE(to_ct_string<-2.5>() == "-2.5");
+        STATIC_REQUIRE(to_ct_string<0.1f>() == "0.1");
+        STATIC_REQUIRE(to_ct_string<16777216.0f>() == "16777216");
+        STATIC_REQUIRE(to_ct_string<5e-324>() == "5e-324");
+        STATIC_REQUIRE(to_ct_string<1.7976931348623157e308>() == "1.7976931348623157e+308");
+        STATIC_REQUIRE(parse_double<to_ct_string<2.2250738585072014e-308>()>() == 2.2250738585072014e-308);
+    }
+
+    SECTION("Notations") {
+        STATIC_REQUIRE(to_ct_string<1500.0, float_format::scientific>() == "1.5e+03");
+        STATIC_REQUIRE(to_ct_string<1500.0, float_format::fixed>() == "1500");
+        STATIC_REQUIRE(to_ct_string<1500.0>() == "1500");
+        STATIC_REQUIRE(to_ct_string<0.001, float_format::fixed>() == "0.001");
+        STATIC_REQUIRE(to_ct_string<0.001>() == "0.001");
+        STATIC_REQUIRE(to_ct_string<0.0001>() == "1e-04");          // Shorter than "0.0001"
+        STATIC_REQUIRE(to_ct_string<1e22>() == "1e+22");
+        STATIC_REQUIRE(to_ct_string<1e23, float_format::fixed>() == "99999999999999991611392"); // Exact value
+        STATIC_REQUIRE(to_ct_string<0.0>() == "0");
+        STATIC_REQUIRE(to_ct_string<-0.0, float_format::scientific>() == "-0e+00");
+    }
+
+    SECTION("Special values") {
+        STATIC_REQUIRE(to_ct_string<std::numeric_limits<double>::infinity()>() == "inf");
+        STATIC_REQUIRE(to_ct_string<-std::numeric_limits<float>::infinity()>() == "-inf");
+    }
+
+    SECTION("Composes with other ct_strings") {
+        constexpr auto label = ct_string("threshold=") + to_ct_string<0.75>() + ct_string(" ms");
+        STATIC_REQUIRE(label == "threshold=0.75 ms");
+    }
+
+    SECTION("Matches std::to_chars") {
+        constexpr double values[] = {0.3, 123.456, 1e-7, 6.02214076e23, 9007199254740993.0};
+        constexpr auto general = std::array{to_ct_string<values[0]>().size(), to_ct_string<values[1]>().size(),
+                                            to_ct_string<values[2]>().size(), to_ct_string<values[3]>().size(),
+                                            to_ct_string<values[4]>().size()};
+        for (std::size_t i = 0; i < 5; ++i) {
+            char buffer[64];
+            const auto result = std::to_chars(buffer, buffer + sizeof(buffer), values[i]);
+            REQUIRE(static_cast<std::size_t>(result.ptr - buffer) == general[i]);
+        }
+        char buffer[64];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), 6.02214076e23, std::chars_format::scientific);
+        REQUIRE(std::string_view(buffer, result.ptr) == to_ct_string<6.02214076e23, float_format::scientific>());
+    }
+}
+
+TEST_CASE("ct_string Binary-to-Text Decoding", "[ct_string][encoding]") {
+    SECTION("hex") {
+        constexpr auto png_magic = hex_decode<"89504E470d0a1a0a">();
+        STATIC_REQUIRE(std::is_same_v<decltype(png_magic), const std::array<std::byte, 8>>);
+        STATIC_REQUIRE(png_magic[0] == std::byte{0x89});
+        STATIC_REQUIRE(png_magic[3] == std::byte{0x47});
+        STATIC_REQUIRE(png_magic[7] == std::byte{0x0A});
+        STATIC_REQUIRE(hex_decode<"">().empty());
+        STATIC_REQUIRE(hex_encode<"\x89PNG">() == "89504e47");
+    }
+
+    SECTION("base64") {
+        STATIC_REQUIRE(base64_encode<"">() == "");
+        STATIC_REQUIRE(base64_encode<"f">() == "Zg==");
+        STATIC_REQUIRE(base64_encode<"fo">() == "Zm8=");
+        STATIC_REQUIRE(base64_encode<"foo">() == "Zm9v");
+        STATIC_REQUIRE(base64_encode<"foobar">() == "Zm9vYmFy");
+        STATIC_REQUIRE(base64_encode<"\xFB\xFF", base64_variant::url>() == "-_8");
+        STATIC_REQUIRE(base64_encode<"\xFB\xFF">() == "+/8=");
+
+        constexpr auto decoded = base64_decode<"Zm9vYg==">();
+        STATIC_REQUIRE(decoded.size() == 4);
+        STATIC_REQUIRE(decoded[0] == std::byte{'f'});
+        STATIC_REQUIRE(decoded[3] == std::byte{'b'});
+        STATIC_REQUIRE(base64_decode<"-_8", base64_variant::url>() == std::array{std::byte{0xFB}, std::byte{0xFF}});
+        STATIC_REQUIRE(base64_decode<base64_encode<"round trip">()>().size() == 10);
+        // base64_decode<"Zm9vYg">() (unpadded standard) and base64_decode<"Zm9vYh==">() (non-zero
+        // trailing bits) are rejected at compile time.
+    }
+
+    SECTION("UUID") {
+        constexpr auto id = parse_uuid<"123e4567-e89b-12d3-a456-426614174000">();
+        STATIC_REQUIRE(id[0] == std::byte{0x12});
+        STATIC_REQUIRE(id[4] == std::byte{0xE8});
+        STATIC_REQUIRE(id[15] == std::byte{0x00});
+        STATIC_REQUIRE(parse_uuid<"{123E4567-E89B-12D3-A456-426614174000}">() == id);
+    }
+}
+
+TEST_CASE("ct_string Checksums and Digests", "[ct_string][digest]") {
+    SECTION("CRC-32 and CRC-32C check values") {
+        STATIC_REQUIRE(crc32_v<"123456789"> == 0xCBF43926u);
+        STATIC_REQUIRE(crc32c_v<"123456789"> == 0xE3069283u);
+        STATIC_REQUIRE(crc32_v<""> == 0u);
+        STATIC_REQUIRE(crc32_v<u8"123456789"> == 0xCBF43926u);
+        // Chained updates give the checksum of the concatenation
+        STATIC_REQUIRE(crc32("6789", crc32("12345")) == 0xCBF43926u);
+        STATIC_REQUIRE(crc32c("89", crc32c("1234567")) == 0xE3069283u);
+    }
+
+    SECTION("MD5 test vectors") {
+        STATIC_REQUIRE(md5_v<""> == hex_decode<"d41d8cd98f00b204e9800998ecf8427e">());
+        STATIC_REQUIRE(md5_v<"abc"> == hex_decode<"900150983cd24fb0d6963f7d28e17f72">());
+        STATIC_REQUIRE(md5_v<"The quick brown fox jumps over the lazy dog"> ==
+                       hex_decode<"9e107d9d372bb6826bd81d3542a419d6">());
+    }
+
+    SECTION("SHA-256 test vectors") {
+        STATIC_REQUIRE(sha256_v<""> == hex_decode<"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855">());
+        STATIC_REQUIRE(sha256_v<"abc"> == hex_decode<"ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad">());
+        // Two-block message whose padding spills into an extra block
+        STATIC_REQUIRE(sha256_v<"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"> ==
+                       hex_decode<"248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1">());
+    }
+
+    SECTION("Runtime results match compile-time results") {
+        std::string text = "The quick brown fox jumps over the lazy dog";
+        REQUIRE(crc32(text) == crc32_v<"The quick brown fox jumps over the lazy dog">);
+        REQUIRE(md5(text) == md5_v<"The quick brown fox jumps over the lazy dog">);
+
+        // One million 'a', fed in uneven pieces to cross block boundaries
+        const std::string million(1000000, 'a');
+        sha256_hasher hasher;
+        for (std::size_t pos = 0; pos < million.size(); pos += 997) {
+            hasher.update(std::string_view(million).substr(pos, 997));
+        }
+        constexpr auto expected = hex_decode<"cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0">();
+        REQUIRE(hasher.finish() == expected);
+        REQUIRE(sha256(million) == expected);
+    }
+}
+
+TEST_CASE("ct_string Schema Fingerprints", "[ct_string][schema]") {
+    using login = schema_message<"Login", schema_field<"user", "string">, schema_field<"id", "u64">>;
+    using say = schema_message<"Say", schema_field<"text", "string">, schema_field<"to", "list<u64>">>;
+    using chat = schema<"chat", login, say>;
+
+    SECTION("Canonical text") {
+        STATIC_REQUIRE(login::canonical_text == "message Login{user:string;id:u64;}");
+        STATIC_REQUIRE(chat::canonical_text ==
+                       "schema chat;message Login{user:string;id:u64;}message Say{text:string;to:list<u64>;}");
+        STATIC_REQUIRE(schema<"empty">::canonical_text == "schema empty;");
+    }
+
+    SECTION("Fingerprint is stable under message order only") {
+        STATIC_REQUIRE(schema<"chat", say, login>::fingerprint == chat::fingerprint);
+        // Field order, types and names are all part of the wire format
+        using swapped = schema_message<"Login", schema_field<"id", "u64">, schema_field<"user", "string">>;
+        STATIC_REQUIRE(schema<"chat", swapped, say>::fingerprint != chat::fingerprint);
+        using retyped = schema_message<"Login", schema_field<"user", "string">, schema_field<"id", "u32">>;
+        STATIC_REQUIRE(schema<"chat", retyped, say>::fingerprint != chat::fingerprint);
+        STATIC_REQUIRE(schema<"chat2", login, say>::fingerprint != chat::fingerprint);
+    }
+
+    SECTION("Runtime fingerprint of the same text") {
+        const std::string text(chat::canonical_text);
+        REQUIRE(schema_fingerprint(text) == chat::fingerprint);
+    }
+}
+
+TEST_CASE("ct_string Runtime Comparison, Hashing and Output", "[ct_string][runtime]") {
+    // Operands come from runtime strings so the out-of-line kernels are exercised
+    constexpr ct_string small = "GET";
+    constexpr ct_string large = "application/x-www-form-urlencoded";
+    const std::string small_copy = "GET";
+    const std::string large_copy = "application/x-www-form-urlencoded";
+    const std::string large_other = "application/x-www-form-urlencodee";
+
+    SECTION("Equality above and below the inline limit") {
+        REQUIRE(small == std::string_view(small_copy));
+        REQUIRE(large == std::string_view(large_copy));
+        REQUIRE(large != std::string_view(large_other));
+        REQUIRE(large != std::string_view(large_copy).substr(1));
+        REQUIRE(std::string_view(large_copy) == large);
+        REQUIRE(large == large_copy.c_str());
+        REQUIRE(large != large_other.c_str());
+        REQUIRE(large != small_copy.c_str());
+        REQUIRE_FALSE(small == static_cast<const char*>(nullptr));
+        REQUIRE(ct_string("") == static_cast<const char*>(nullptr));
+        // A shorter C string must not match a prefix, nor a longer one the whole string
+        REQUIRE_FALSE(small == "GE");
+        REQUIRE_FALSE(small == std::string("GETS").c_str());
+    }
+
+    SECTION("Embedded nulls") {
+        constexpr ct_string with_null = "a\0b";
+        REQUIRE(with_null == std::string_view("a\0b", 3));
+        REQUIRE_FALSE(with_null == std::string("a").c_str());
+    }
+
+    SECTION("Three-way comparison") {
+        REQUIRE(std::is_eq(large <=> std::string_view(large_copy)));
+        REQUIRE(std::is_lt(large <=> std::string_view(large_other)));
+        REQUIRE(std::is_gt(large <=> std::string_view(large_copy).substr(0, 20)));
+        REQUIRE(std::is_lt(small <=> std::string_view(large_copy)));
+        REQUIRE(large < large_other.c_str());
+        REQUIRE(u"abc" < std::u16string_view(u"abd"));
+    }
+
+    SECTION("Stream output") {
+        std::ostringstream os;
+        os << small << ' ' << large;
+        REQUIRE(os.str() == "GET application/x-www-form-urlencoded");
+
+        std::ostringstream padded;
+        padded.width(6);
+        padded << small;
+        REQUIRE(padded.str() == "   GET");
+
+        std::wostringstream wide;
+        wide << ct_string(L"wide");
+        REQUIRE(wide.str() == L"wide");
+    }
+
+    SECTION("std::hash matches std::string_view") {
+        REQUIRE(std::hash<ct_string<33>>{}(large) == std::hash<std::string_view>{}(large_copy));
+        REQUIRE(std::hash<u16ct_string<1>>{}(ct_string(u"x")) == std::hash<std::u16string_view>{}(u"x"));
+        std::unordered_set<std::string_view> known = {small, large};
+        REQUIRE(known.contains(large_copy));
+    }
+}
+
+namespace {
+constexpr auto embedded = from_embedded(embedded_sample);
+}
+
+TEST_CASE("ct_string Embedded Resources", "[ct_string][embed]") {
+    SECTION("File contents become a ct_string constant") {
+        STATIC_REQUIRE(embedded.size() == 10);
+        STATIC_REQUIRE(embedded == "port=8080\n");
+        STATIC_REQUIRE(from_embedded<char8_t>(embedded_sample) == u8"port=8080\n");
+    }
+
+    SECTION("Compile-time transforms apply to embedded files") {
+        STATIC_REQUIRE(crc32_v<embedded> == crc32("port=8080\n"));
+        STATIC_REQUIRE(sha256_v<embedded> == sha256("port=8080\n"));
+        STATIC_REQUIRE(to_upper<embedded>() == "PORT=8080\n");
+        STATIC_REQUIRE(embedded.find("8080") == 5);
+        STATIC_REQUIRE(is_ascii_v<embedded>);
+    }
+
+    SECTION("Bytes are copied verbatim") {
+        constexpr unsigned char empty[] = {0};
+        constexpr unsigned char binary[] = {0xFF, 0x00, 0x7F, 0};
+        STATIC_REQUIRE(from_embedded(empty).empty());
+        constexpr auto bytes = from_embedded(binary);
+        STATIC_REQUIRE(bytes.size() == 3);
+        STATIC_REQUIRE(bytes[0] == '\xFF');
+        STATIC_REQUIRE(bytes[1] == '\0');
+        STATIC_REQUIRE(bytes[2] == '\x7F');
+    }
+}
+
+namespace {
+// Index of the first key with each first letter, as a derivation for ct_cached
+inline constexpr auto build_initial_index = [](const auto&... keys) {
+    std::array<int, 26> index{};
+    index.fill(-1);
+    int position = 0;
+    ((index[keys[0] - 'a'] = index[keys[0] - 'a'] < 0 ? position : index[keys[0] - 'a'], ++position), ...);
+    return index;
+};
+}
+
+TEST_CASE("ct_string Cached Derivations", "[ct_string][cache]") {
+    SECTION("ct_cached stores the derivation of its inputs") {
+        constexpr const auto& index = ct_cached<build_initial_index, "if", "else", "while", "ensure">;
+        STATIC_REQUIRE(index['i' - 'a'] == 0);
+        STATIC_REQUIRE(index['e' - 'a'] == 1);
+        STATIC_REQUIRE(index['w' - 'a'] == 2);
+        STATIC_REQUIRE(index['x' - 'a'] == -1);
+    }
+
+    SECTION("The same inputs name the same object") {
+        STATIC_REQUIRE(&ct_cached<build_initial_index, "if", "else"> == &ct_cached<build_initial_index, "if", "else">);
+        STATIC_REQUIRE(&ct_cached<build_initial_index, "if", "else"> != &ct_cached<build_initial_index, "else", "if">);
+    }
+
+    SECTION("Library transforms return their cached results") {
+        STATIC_REQUIRE(to_lower<"MiXeD">() == "mixed");
+        STATIC_REQUIRE(to_upper<"MiXeD">() == "MIXED");
+        STATIC_REQUIRE(to_utf16<"Grüße">() == u"Grüße");
+        STATIC_REQUIRE(hex_encode<"\x01\xAB">() == "01ab");
+        STATIC_REQUIRE(base64_encode<"hi", base64_variant::url>() == "aGk");
+    }
+}
+
+namespace {
+consteval source_here location_of_helper() {
+    return ct_here();
+}
+
+// Longer than source_text_capacity (256) on its own
+consteval source_here location_of_a_helper_whose_name_is_longer_than_the_text_a_source_here_keeps_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_end() {
+    return ct_here();
+}
+
+consteval source_here long_named_location() {
+    return location_of_a_helper_whose_name_is_longer_than_the_text_a_source_here_keeps_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_and_then_some_more_end();
+}
+}
+
+TEST_CASE("ct_string Source Locations", "[ct_string][source]") {
+    SECTION("ct_here captures the call site") {
+        constexpr auto here = ct_here();
+        STATIC_REQUIRE(here.line == __LINE__ - 1);
+        STATIC_REQUIRE(here.basename() == "test_ct_string.cpp");
+        STATIC_REQUIRE(location_of_helper().function().find("location_of_helper") != std::string_view::npos);
+        // Names that do not fit are cut and marked
+        constexpr auto long_name = long_named_location();
+        STATIC_REQUIRE(long_name.function().size() == 256);
+        STATIC_REQUIRE(long_name.function().ends_with("..."));
+        STATIC_REQUIRE(long_name.function().find("location_of_a_helper_whose_name") != std::string_view::npos);
+        STATIC_REQUIRE(source_function_v<long_named_location()>.size() == 256);
+#ifdef CT_STRING_SOURCE_PREFIXES
+        // The ct_string CMake target strips the top-level source directory
+        STATIC_REQUIRE(here.file() == "test/test_ct_string.cpp");
+#endif
+    }
+
+    SECTION("Explicit prefixes replace the configured ones") {
+        constexpr std::string_view path = __FILE__;
+        constexpr auto kept = ct_here<"/no/such/dir/">();
+        STATIC_REQUIRE(kept.file() == path);
+
+        // Whichever prefix matches is stripped; '/' and '\\' are interchangeable
+        constexpr auto stripped = ct_here<"/", "\\", "/no/such/dir/">();
+        constexpr bool absolute = path.starts_with('/') || path.starts_with('\\');
+        STATIC_REQUIRE(stripped.file() == path.substr(absolute ? 1 : 0));
+    }
+
+    SECTION("Locations become ct_string constants") {
+        constexpr auto file = source_basename_v<ct_here()>;
+        STATIC_REQUIRE(std::is_same_v<std::remove_const_t<decltype(file)>, ct_string<18>>);
+        STATIC_REQUIRE(file == "test_ct_string.cpp");
+        STATIC_REQUIRE(source_file_v<ct_here<"">()> == ct_string(__FILE__));
+    }
+}
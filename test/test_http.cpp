@@ -0,0 +1,123 @@
+// File: test_http.cpp
+// HTTP response preambles assembled at compile time, and responses written with writev()
+// through a pipe.
+#include <catch2/catch_test_macros.hpp>
+#include <cerrno>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#if __has_include(<unistd.h>)
+#include <sys/wait.h>  // For waitpid
+#include <unistd.h>    // For pipe, read, close
+#endif
+
+#ifdef CT_STRING_HEADER_ONLY
+#include <ct_string/ct_string.http.hpp>
+#else
+import ct_string.http;
+#endif
+
+namespace {
+
+using json_ok = http_status<200>;
+using server = http_header<"Server", "ct_string">;
+using json = http_header<"Content-Type", "application/json; charset=utf-8">;
+
+} // namespace
+
+TEST_CASE("http Preambles", "[http]") {
+    SECTION("Status lines") {
+        STATIC_REQUIRE(http_status<200>::text == "HTTP/1.1 200 OK\r\n");
+        STATIC_REQUIRE(http_status<404>::text == "HTTP/1.1 404 Not Found\r\n");
+        STATIC_REQUIRE(http_status<599, "Network Connect Timeout">::text == "HTTP/1.1 599 Network Connect Timeout\r\n");
+        STATIC_REQUIRE(http_status<503, "Busy">::reason == "Busy");
+    }
+
+    SECTION("Header lines are concatenated into one constant") {
+        constexpr const auto& head = http_preamble_v<json_ok, server, json>;
+        STATIC_REQUIRE(head == "HTTP/1.1 200 OK\r\n"
+                               "Server: ct_string\r\n"
+                               "Content-Type: application/json; charset=utf-8\r\n");
+        STATIC_REQUIRE(&http_preamble_v<json_ok, server, json> == &head);
+        STATIC_REQUIRE(http_preamble_v<http_status<204>> == "HTTP/1.1 204 No Content\r\n");
+    }
+
+    SECTION("Constant responses carry their Content-Length") {
+        STATIC_REQUIRE(http_response_v<http_status<404>, "not found\n", server> ==
+                       "HTTP/1.1 404 Not Found\r\n"
+                       "Server: ct_string\r\n"
+                       "Content-Length: 10\r\n"
+                       "\r\n"
+                       "not found\n");
+        STATIC_REQUIRE(http_response_v<http_status<204>, ""> == "HTTP/1.1 204 No Content\r\nContent-Length: 0\r\n\r\n");
+    }
+}
+
+#if __has_include(<unistd.h>)
+
+namespace {
+
+std::string read_all(int fd) {
+    std::string out;
+    char buffer[4096];
+    for (ssize_t n; (n = ::read(fd, buffer, sizeof(buffer))) > 0;) {
+        out.append(buffer, static_cast<std::size_t>(n));
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("http Responses through writev", "[http]") {
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+
+    SECTION("Preamble, fields, blank line and body in order") {
+        const std::string body = R"({"id":7})";
+        const std::string length = std::to_string(body.size());
+        const http_field fields[] = {{"Content-Length", length}, {"X-Request-Id", "abc-123"}};
+        REQUIRE(write_http_response(fds[1], http_preamble_v<json_ok, server, json>, fields, body));
+        ::close(fds[1]);
+        REQUIRE(read_all(fds[0]) == "HTTP/1.1 200 OK\r\n"
+                                    "Server: ct_string\r\n"
+                                    "Content-Type: application/json; charset=utf-8\r\n"
+                                    "Content-Length: 8\r\n"
+                                    "X-Request-Id: abc-123\r\n"
+                                    "\r\n"
+                                    R"({"id":7})");
+    }
+
+    SECTION("Responses larger than the pipe are written completely") {
+        const std::string body(1 << 20, 'x');
+        std::string received;
+        // The pipe holds 64 KiB, so the reader has to run concurrently
+        const pid_t child = ::fork();
+        REQUIRE(child >= 0);
+        if (child == 0) {
+            ::close(fds[0]);
+            const bool ok = write_http_response(fds[1], http_preamble_v<json_ok>, {}, body);
+            ::_exit(ok ? 0 : 1);
+        }
+        ::close(fds[1]);
+        received = read_all(fds[0]);
+        int status = 0;
+        REQUIRE(::waitpid(child, &status, 0) == child);
+        REQUIRE((WIFEXITED(status) && WEXITSTATUS(status) == 0));
+        REQUIRE(received == std::string(http_preamble_v<json_ok>) + "\r\n" + body);
+    }
+
+    SECTION("Fields that could end the header section are rejected") {
+        const http_field injected[] = {{"X-Note", "a\r\n\r\nHTTP/1.1 200 OK"}};
+        errno = 0;
+        REQUIRE_FALSE(write_http_response(fds[1], http_preamble_v<json_ok>, injected));
+        REQUIRE(errno == EINVAL);
+        const http_field bad_name[] = {{"X Note", "a"}};
+        REQUIRE_FALSE(write_http_response(fds[1], http_preamble_v<json_ok>, bad_name));
+        ::close(fds[1]);
+        REQUIRE(read_all(fds[0]).empty());
+    }
+
+    ::close(fds[0]);
+}
+
+#endif
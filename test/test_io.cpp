@@ -0,0 +1,169 @@
+// File: test_io.cpp
+// Scatter-gather output: which pieces iovec_writer copies or references, and what arrives
+// through pipes, files and sockets.
+#include <catch2/catch_test_macros.hpp>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>      // For std::tmpfile
+#include <string>
+#include <string_view>
+#if __has_include(<unistd.h>)
+#include <sys/socket.h> // For socketpair
+#include <sys/wait.h>   // For waitpid
+#include <unistd.h>     // For pipe, read, close
+#endif
+
+#ifdef CT_STRING_HEADER_ONLY
+#include <ct_string/ct_string.io.hpp>
+#else
+import ct_string.io;
+#endif
+
+#if __has_include(<unistd.h>)
+
+namespace {
+
+std::string read_all(int fd) {
+    std::string out;
+    char buffer[4096];
+    for (ssize_t n; (n = ::read(fd, buffer, sizeof(buffer))) > 0;) {
+        out.append(buffer, static_cast<std::size_t>(n));
+    }
+    return out;
+}
+
+struct pipe_pair {
+    int read_end = -1;
+    int write_end = -1;
+
+    pipe_pair() {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        read_end = fds[0];
+        write_end = fds[1];
+    }
+    ~pipe_pair() {
+        ::close(read_end);
+        close_write();
+    }
+    void close_write() {
+        if (write_end >= 0) {
+            ::close(write_end);
+            write_end = -1;
+        }
+    }
+};
+
+} // namespace
+
+TEST_CASE("iovec_writer Segments", "[io]") {
+    pipe_pair pipe;
+
+    SECTION("Constants and long text are referenced, short text is copied and merged") {
+        const std::string long_value(40, 'v');
+        iovec_writer out(pipe.write_end);
+        out.append<"Content-Type: application/octet-stream\r\n">();
+        REQUIRE(out.segments() == 1);
+        REQUIRE(out.buffered_bytes() == 0);
+
+        out.append("X-Id").append<": ">().append(std::uint64_t{42}).append<"\r\n">();
+        REQUIRE(out.segments() == 2); // Four short pieces in one copied segment
+        REQUIRE(out.buffered_bytes() == 10);
+
+        out.append(long_value).append('\n');
+        REQUIRE(out.segments() == 4);
+        REQUIRE(out.pending_bytes() == 40 + 10 + 40 + 1);
+
+        REQUIRE(out.flush());
+        REQUIRE(out.segments() == 0);
+        pipe.close_write();
+        REQUIRE(read_all(pipe.read_end) == "Content-Type: application/octet-stream\r\nX-Id: 42\r\n" + long_value + "\n");
+    }
+
+    SECTION("Numbers are formatted into the buffer") {
+        iovec_writer out(pipe.write_end);
+        out.append(-7).append(' ').append(std::uint16_t{65535}).append(' ').append(0.5).append(' ').append(1e21);
+        REQUIRE(out.segments() == 1);
+        REQUIRE(out.flush());
+        pipe.close_write();
+        REQUIRE(read_all(pipe.read_end) == "-7 65535 0.5 1e+21");
+    }
+
+    SECTION("Full queues are flushed automatically and keep the order") {
+        iovec_writer<4, 32, 8> out(pipe.write_end);
+        const std::string text = "referenced text";
+        std::string expected;
+        for (int i = 0; i < 20; ++i) {
+            out.append(text).append(i).append<";">();
+            expected += text + std::to_string(i) + ";";
+            REQUIRE(out.segments() <= 4);
+            REQUIRE(out.buffered_bytes() <= 32);
+        }
+        out.append_copy(std::string(100, 'c'));
+        expected += std::string(100, 'c');
+        REQUIRE(out.flush());
+        pipe.close_write();
+        REQUIRE(read_all(pipe.read_end) == expected);
+    }
+}
+
+TEST_CASE("iovec_writer Destinations", "[io]") {
+    SECTION("Files") {
+        std::FILE* file = std::tmpfile();
+        REQUIRE(file != nullptr);
+        const int fd = ::fileno(file);
+        iovec_writer out(fd);
+        out.append<"line one\n">().append<"line two\n">().append(std::string_view("line three, long enough to be referenced\n"));
+        REQUIRE(out.flush());
+        REQUIRE(::lseek(fd, 0, SEEK_SET) == 0);
+        REQUIRE(read_all(fd) == "line one\nline two\nline three, long enough to be referenced\n");
+        std::fclose(file);
+    }
+
+    SECTION("Sockets through sendmsg, larger than the socket buffer") {
+        int fds[2];
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        const std::string payload(1 << 20, 'p');
+        const pid_t child = ::fork();
+        REQUIRE(child >= 0);
+        if (child == 0) {
+            ::close(fds[0]);
+            iovec_writer out(fds[1], iovec_flush::sendmsg);
+            out.append<"begin:">().append(payload).append<":end">();
+            ::_exit(out.flush() ? 0 : 1);
+        }
+        ::close(fds[1]);
+        const std::string received = read_all(fds[0]);
+        ::close(fds[0]);
+        int status = 0;
+        REQUIRE(::waitpid(child, &status, 0) == child);
+        REQUIRE((WIFEXITED(status) && WEXITSTATUS(status) == 0));
+        REQUIRE(received == "begin:" + payload + ":end");
+    }
+
+    SECTION("Failures are reported and sticky") {
+        int fds[2];
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        ::close(fds[0]);
+        iovec_writer out(fds[1], iovec_flush::sendmsg); // MSG_NOSIGNAL: EPIPE instead of SIGPIPE
+        out.append<"nobody is listening">();
+        REQUIRE_FALSE(out.flush());
+        REQUIRE(errno == EPIPE);
+        REQUIRE_FALSE(out.ok());
+        out.append<"more">();
+        REQUIRE(out.segments() == 0);
+        errno = 0;
+        REQUIRE_FALSE(out.flush());
+        REQUIRE(errno == EPIPE);
+        out.clear();
+        REQUIRE(out.ok());
+        ::close(fds[1]);
+
+        iovec_writer closed(-1);
+        closed.append<"x">();
+        REQUIRE_FALSE(closed.flush());
+        REQUIRE(errno == EBADF);
+    }
+}
+
+#endif
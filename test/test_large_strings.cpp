@@ -0,0 +1,81 @@
+// File: test_large_strings.cpp
+// Compile-time algorithms on megabyte-sized strings. This file is built with the raised
+// constexpr budgets of ct_string_raise_constexpr_limits(); besides the results it checks that
+// no single loop exceeds GCC's -fconstexpr-loop-limit, which is not raised.
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <compare>
+#include <string_view>
+
+#ifdef CT_STRING_HEADER_ONLY
+#include <ct_string/ct_string.hpp>
+#else
+import ct_string;
+#endif
+
+namespace {
+
+constexpr std::size_t mib = std::size_t{1} << 20;
+
+// "abcd...zabcd..." of length N, written in blocks so the generator itself stays under the loop limit
+template<std::size_t N>
+constexpr auto alphabet_string() {
+    ct_string<N> result{};
+    char* out = result.data.data();
+    for (std::size_t block = 0; block < N; block += 4096) {
+        for (std::size_t i = block; i < block + 4096 && i < N; ++i) {
+            out[i] = static_cast<char>('a' + i % 26);
+        }
+    }
+    return result;
+}
+
+constexpr auto big = alphabet_string<mib>();
+
+constexpr auto big_bumped = [] {
+    auto result = big;
+    result.data[mib - 1] = '~';
+    return result;
+}();
+
+} // namespace
+
+TEST_CASE("ct_string megabyte constants", "[ct_string][large]") {
+    SECTION("Concatenation") {
+        constexpr auto joined = big + big;
+        STATIC_REQUIRE(joined.size() == 2 * mib);
+        STATIC_REQUIRE(joined[mib - 1] == big[mib - 1]);
+        STATIC_REQUIRE(joined[mib] == 'a');
+        STATIC_REQUIRE(joined[2 * mib] == '\0');
+    }
+
+    SECTION("Comparison") {
+        STATIC_REQUIRE(big == big);
+        STATIC_REQUIRE(big != big_bumped);
+        STATIC_REQUIRE((big <=> big_bumped) < 0);
+        STATIC_REQUIRE(big == std::string_view(big));
+        STATIC_REQUIRE(big == big.c_str());
+    }
+
+    SECTION("Search") {
+        // The only '~' is the last character; the needle's prefix repeats throughout the haystack
+        STATIC_REQUIRE(big_bumped.find("stu~") == mib - 4);
+        STATIC_REQUIRE(big.find("stu~") == big.npos);
+        STATIC_REQUIRE(big.find("zab", mib - 30) == mib - 23);
+        STATIC_REQUIRE(big_bumped.contains("~"));
+    }
+
+    SECTION("Transformation and properties") {
+        constexpr auto upper = to_upper<big>();
+        STATIC_REQUIRE(upper[0] == 'A');
+        STATIC_REQUIRE(upper[mib - 1] == big[mib - 1] - ('a' - 'A'));
+        STATIC_REQUIRE(is_ascii_v<big>);
+        STATIC_REQUIRE_FALSE(contains_nul_v<big>);
+    }
+
+    SECTION("Checksums") {
+        STATIC_REQUIRE(crc32(big) == 0x26e252acu);
+        STATIC_REQUIRE(crc32(to_upper<big>()) == 0x70d9ba17u);
+    }
+}
@@ -0,0 +1,138 @@
+// File: test_log.cpp
+// Deferred-formatting logging: records written by ct_log() on several threads, drained and
+// formatted afterwards.
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef CT_STRING_HEADER_ONLY
+#include <ct_string/ct_string.log.hpp>
+#else
+import ct_string.log;
+#endif
+
+namespace {
+
+enum class color : std::uint8_t { red = 1, green = 2 };
+
+struct entry {
+    const log_site* site;
+    std::string message;
+};
+
+std::vector<entry> drain_all() {
+    std::vector<entry> entries;
+    log_backend::instance().drain([&](const log_site& site, std::span<const std::byte> payload) {
+        entries.push_back({&site, format_log_record(site, payload)});
+    });
+    return entries;
+}
+
+} // namespace
+
+TEST_CASE("ct_log Records and Formatting", "[log]") {
+    drain_all();
+
+    SECTION("Arguments are stored raw and formatted on drain") {
+        const std::string owner = "alice";
+        REQUIRE(ct_log<"user {} logged in from {}:{}", __FILE__, __LINE__>(owner, "10.0.0.1", std::uint16_t{8080}));
+        REQUIRE(ct_log<"ratio={} ok={} grade={} color={}">(0.25, true, 'B', color::green));
+        REQUIRE(ct_log<"min={} max={}">(std::int64_t{-9223372036854775807 - 1}, std::uint64_t{18446744073709551615u}));
+        REQUIRE(ct_log<"{{literal}} {}">(ct_string("braces")));
+
+        const auto entries = drain_all();
+        REQUIRE(entries.size() == 4);
+        REQUIRE(entries[0].message == "user alice logged in from 10.0.0.1:8080");
+        REQUIRE(entries[1].message == "ratio=0.25 ok=true grade=B color=2");
+        REQUIRE(entries[2].message == "min=-9223372036854775808 max=18446744073709551615");
+        REQUIRE(entries[3].message == "{literal} braces");
+    }
+
+    SECTION("Call sites carry their metadata") {
+        ct_log<"at {}", "server.cpp", 42>(1);
+        const auto entries = drain_all();
+        REQUIRE(entries.size() == 1);
+        const log_site& site = *entries[0].site;
+        REQUIRE(site.format == "at {}");
+        REQUIRE(site.file == "server.cpp");
+        REQUIRE(site.line == 42);
+        REQUIRE(site.args.size() == 1);
+        REQUIRE(site.args[0] == log_arg::int32);
+        REQUIRE(find_log_site(site.id) == &site);
+    }
+
+    SECTION("ct_here supplies file, function and line") {
+        constexpr auto here = ct_here();
+        ct_log<"at {}", here>(2);
+        const auto entries = drain_all();
+        REQUIRE(entries.size() == 1);
+        const log_site& site = *entries[0].site;
+        REQUIRE(site.file == here.file());
+        REQUIRE(site.file.ends_with("test_log.cpp"));
+        REQUIRE(site.function == here.function());
+        REQUIRE(site.line == here.line);
+        REQUIRE(entries[0].message == "at 2");
+    }
+
+    SECTION("Each thread writes to its own ring") {
+        constexpr int per_thread = 1000;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([t] {
+                for (int i = 0; i < per_thread; ++i) {
+                    while (!ct_log<"thread {} record {}">(t, i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        std::vector<entry> entries;
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        entries = drain_all();
+        REQUIRE(entries.size() == 4 * per_thread);
+        // Records of one thread stay in order
+        int next[4] = {};
+        for (const auto& e : entries) {
+            const int t = e.message[7] - '0';
+            REQUIRE(e.message == "thread " + std::to_string(t) + " record " + std::to_string(next[t]));
+            ++next[t];
+        }
+    }
+}
+
+TEST_CASE("ct_log Ring Buffer", "[log]") {
+    SECTION("Records wrap around the end of the ring") {
+        log_ring ring(4096);
+        std::vector<std::uint32_t> seen;
+        for (std::uint32_t i = 1; i <= 2000; ++i) {
+            REQUIRE(ring.write(i, std::string(i % 100, 'x'), i));
+            ring.drain([&](std::uint32_t id, std::span<const std::byte> payload) {
+                seen.push_back(id);
+                REQUIRE(payload.size() >= 8 + id % 100);
+            });
+        }
+        REQUIRE(seen.size() == 2000);
+        REQUIRE(seen.back() == 2000);
+        REQUIRE(ring.dropped() == 0);
+    }
+
+    SECTION("A full ring drops records instead of blocking") {
+        log_ring ring(4096);
+        std::size_t written = 0;
+        while (ring.write(1, std::uint64_t{0})) {
+            ++written;
+        }
+        REQUIRE(written == 4096 / 16);
+        REQUIRE(ring.dropped() == 1);
+        REQUIRE(ring.drain([](std::uint32_t, std::span<const std::byte>) {}) == written);
+        REQUIRE(ring.empty());
+        REQUIRE(ring.write(1, std::uint64_t{0}));
+    }
+}
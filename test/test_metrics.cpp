@@ -0,0 +1,112 @@
+// File: test_metrics.cpp
+// Metrics declared by name: per-thread shards summed by scrape(), gauges, histograms and the
+// Prometheus text output.
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef CT_STRING_HEADER_ONLY
+#include <ct_string/ct_string.metrics.hpp>
+#else
+import ct_string.metrics;
+#endif
+
+namespace {
+
+using server_metrics = metric_registry<metric_counter<"requests_total">,
+                                       metric_gauge<"connections">,
+                                       metric_histogram<"latency_us", 10, 100, 1000>,
+                                       metric_counter<"errors_total">>;
+
+// A second registry with its own storage
+using other_metrics = metric_registry<metric_counter<"requests_total">>;
+
+} // namespace
+
+TEST_CASE("metric_registry Layout", "[metrics]") {
+    SECTION("Names resolve at compile time") {
+        STATIC_REQUIRE(server_metrics::size() == 4);
+        STATIC_REQUIRE(server_metrics::name(0) == "requests_total");
+        STATIC_REQUIRE(server_metrics::name(2) == "latency_us");
+        STATIC_REQUIRE(server_metrics::name(3) == "errors_total");
+        STATIC_REQUIRE(server_metrics::kind(1) == metric_kind::gauge);
+        STATIC_REQUIRE(server_metrics::kind(2) == metric_kind::histogram);
+        STATIC_REQUIRE(server_metrics::name_pool == "requests_totalconnectionslatency_userrors_total");
+    }
+}
+
+TEST_CASE("metric_registry Updates and Scrapes", "[metrics]") {
+    const auto before = server_metrics::scrape();
+
+    SECTION("Counters are summed across threads, including exited ones") {
+        constexpr int threads = 8;
+        constexpr std::uint64_t per_thread = 10000;
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([] {
+                for (std::uint64_t i = 0; i < per_thread; ++i) {
+                    server_metrics::increment<"requests_total">();
+                }
+                server_metrics::increment<"errors_total">(3);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        server_metrics::increment<"requests_total">(5);
+
+        const auto after = server_metrics::scrape();
+        REQUIRE(after.get<"requests_total">() - before.get<"requests_total">() == threads * per_thread + 5);
+        REQUIRE(after.get<"errors_total">() - before.get<"errors_total">() == threads * 3);
+        REQUIRE(other_metrics::scrape().get<"requests_total">() == 0);
+    }
+
+    SECTION("Gauges hold the last value") {
+        server_metrics::set<"connections">(10);
+        server_metrics::add<"connections">(-3);
+        REQUIRE(server_metrics::scrape().get<"connections">() == 7);
+    }
+
+    SECTION("Histograms count values per bucket") {
+        std::thread([] {
+            server_metrics::observe<"latency_us">(5);
+            server_metrics::observe<"latency_us">(10);
+        }).join();
+        server_metrics::observe<"latency_us">(11);
+        server_metrics::observe<"latency_us">(5000);
+
+        const auto latency = server_metrics::scrape().get<"latency_us">();
+        const auto earlier = before.get<"latency_us">();
+        REQUIRE(latency.buckets[0] - earlier.buckets[0] == 2);
+        REQUIRE(latency.buckets[1] - earlier.buckets[1] == 1);
+        REQUIRE(latency.buckets[2] - earlier.buckets[2] == 0);
+        REQUIRE(latency.buckets[3] - earlier.buckets[3] == 1);
+        REQUIRE(latency.sum - earlier.sum == 5026);
+        REQUIRE(latency.count() - earlier.count() == 4);
+    }
+}
+
+TEST_CASE("metric_registry Text Format", "[metrics]") {
+    using metrics = metric_registry<metric_counter<"jobs_total">, metric_gauge<"queue_depth">,
+                                    metric_histogram<"job_ms", 1, 10>>;
+    metrics::increment<"jobs_total">(2);
+    metrics::set<"queue_depth">(-1);
+    metrics::observe<"job_ms">(1);
+    metrics::observe<"job_ms">(7);
+    metrics::observe<"job_ms">(70);
+
+    REQUIRE(metrics::scrape().to_prometheus() ==
+            "# TYPE jobs_total counter\n"
+            "jobs_total 2\n"
+            "# TYPE queue_depth gauge\n"
+            "queue_depth -1\n"
+            "# TYPE job_ms histogram\n"
+            "job_ms_bucket{le=\"1\"} 1\n"
+            "job_ms_bucket{le=\"10\"} 2\n"
+            "job_ms_bucket{le=\"+Inf\"} 3\n"
+            "job_ms_sum 78\n"
+            "job_ms_count 3\n");
+}
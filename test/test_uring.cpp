@@ -0,0 +1,165 @@
+// File: test_uring.cpp
+// io_uring fixed buffers: payload layout, registration, and fixed writes to pipes, files and
+// sockets. Skipped where the kernel has no io_uring or it is disabled.
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>      // For std::tmpfile
+#include <string>
+#include <string_view>
+#if __has_include(<linux/io_uring.h>)
+#include <sys/socket.h> // For socketpair
+#include <sys/uio.h>    // For struct iovec
+#include <unistd.h>     // For pipe, read, close
+#endif
+
+#ifdef CT_STRING_HEADER_ONLY
+#include <ct_string/ct_string.uring.hpp>
+#else
+import ct_string.uring;
+#endif
+
+#if __has_include(<linux/io_uring.h>)
+
+namespace {
+
+constexpr ct_string banner = "220 ready\r\n";
+constexpr ct_string busy = "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n";
+constexpr auto large = [] { // Spans two pages
+    ct_string<5000> text{};
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        text.data[i] = "0123456789abcdef"[i % 16];
+    }
+    return text;
+}();
+
+using canned = fixed_payloads<banner, busy, large>;
+
+std::string read_exactly(int fd, std::size_t size) {
+    std::string out(size, '\0');
+    std::size_t done = 0;
+    while (done < size) {
+        const ssize_t n = ::read(fd, out.data() + done, size - done);
+        if (n <= 0) {
+            break;
+        }
+        done += static_cast<std::size_t>(n);
+    }
+    out.resize(done);
+    return out;
+}
+
+// Submits everything prepared, waits for count completions and returns the result of each,
+// indexed by user data
+template<std::size_t N>
+std::array<int, N> complete(uring_queue& ring, unsigned count) {
+    std::array<int, N> results{};
+    REQUIRE(ring.submit(count) == static_cast<int>(count));
+    unsigned reaped = 0;
+    while (reaped < count) {
+        reaped += ring.reap([&](std::uint64_t user_data, int result) { results[user_data] = result; });
+    }
+    return results;
+}
+
+} // namespace
+
+TEST_CASE("fixed_payloads Layout", "[uring]") {
+    STATIC_REQUIRE(canned::size() == 3);
+    STATIC_REQUIRE(canned::index_of<banner>() == 0);
+    STATIC_REQUIRE(canned::index_of<large>() == 2);
+    STATIC_REQUIRE(canned::index_of<"220 ready\r\n">() == 0);
+
+    const auto buffers = canned::iovecs();
+    for (std::size_t i = 0; i < canned::size(); ++i) {
+        REQUIRE(reinterpret_cast<std::uintptr_t>(buffers[i].iov_base) % fixed_payload_alignment == 0);
+        REQUIRE(buffers[i].iov_base == canned::payload(i).data());
+        REQUIRE(buffers[i].iov_len == canned::payload(i).size());
+    }
+    REQUIRE(canned::payload(0) == std::string_view(banner));
+    REQUIRE(canned::payload(1) == std::string_view(busy));
+    REQUIRE(canned::payload(2) == std::string_view(large));
+}
+
+TEST_CASE("fixed_payloads Writes", "[uring]") {
+    uring_queue ring(8);
+    if (!ring.valid()) {
+        WARN("io_uring is not available, errno " << ring.error());
+        return;
+    }
+    REQUIRE(canned::register_with(ring));
+
+    SECTION("Pipes") {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        REQUIRE(canned::prepare_write<banner>(ring, fds[1], 0));
+        REQUIRE(canned::prepare_write<busy>(ring, fds[1], 1));
+        const auto results = complete<2>(ring, 2);
+        REQUIRE(results[0] == static_cast<int>(banner.size()));
+        REQUIRE(results[1] == static_cast<int>(busy.size()));
+        // Operations run in any order unless linked, so compare the bytes as a set
+        const std::string received = read_exactly(fds[0], banner.size() + busy.size());
+        REQUIRE((received == std::string(banner) + std::string(busy) || received == std::string(busy) + std::string(banner)));
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    SECTION("Files at an offset") {
+        std::FILE* file = std::tmpfile();
+        REQUIRE(file != nullptr);
+        const int fd = ::fileno(file);
+        REQUIRE(canned::prepare_write<large>(ring, fd, 0, 0));
+        REQUIRE(canned::prepare_write<banner>(ring, fd, 1, large.size()));
+        const auto results = complete<2>(ring, 2);
+        REQUIRE(results[0] == static_cast<int>(large.size()));
+        REQUIRE(results[1] == static_cast<int>(banner.size()));
+        REQUIRE(::lseek(fd, 0, SEEK_SET) == 0);
+        REQUIRE(read_exactly(fd, large.size() + banner.size() + 1) == std::string(large) + std::string(banner));
+        std::fclose(file);
+    }
+
+    SECTION("Sockets") {
+        int fds[2];
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        REQUIRE(canned::prepare_write<busy>(ring, fds[1], 0));
+        const auto results = complete<1>(ring, 1);
+        REQUIRE(results[0] == static_cast<int>(busy.size()));
+        REQUIRE(read_exactly(fds[0], busy.size()) == std::string_view(busy));
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    SECTION("Ordinary writes share the ring, and errors come back as results") {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        const std::string dynamic = "per-request text";
+        REQUIRE(ring.prepare_write(fds[1], dynamic.data(), static_cast<std::uint32_t>(dynamic.size()), 0));
+        REQUIRE(canned::prepare_write<banner>(ring, -1, 1));
+        const auto results = complete<2>(ring, 2);
+        REQUIRE(results[0] == static_cast<int>(dynamic.size()));
+        REQUIRE(results[1] == -EBADF);
+        REQUIRE(read_exactly(fds[0], dynamic.size()) == dynamic);
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    SECTION("A full submission queue is reported") {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        unsigned prepared = 0;
+        while (canned::prepare_write<banner>(ring, fds[1], prepared)) {
+            ++prepared;
+        }
+        REQUIRE(errno == EBUSY);
+        REQUIRE(prepared == 8);
+        complete<8>(ring, prepared);
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    REQUIRE(ring.unregister_buffers());
+}
+
+#endif
@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+"""Reports the template bloat ct_string usage leaves in object files.
+
+Every distinct length is a distinct ct_string<N, CharT> type, and every string used as a
+template argument is a distinct specialization of whatever it parameterizes. This script
+reads the symbol tables of compiled objects and attributes their .text and .rodata bytes:
+
+    ct_string types     symbols mentioning ct_string<N, CharT>, grouped by the first such type
+    operator+           emitted operator+<N1, N2, CharT> specializations
+    parameter objects   template parameter objects (one per distinct string value used as NTTP)
+
+Emitted symbols only show what survived constant evaluation and inlining. With Clang, pass
+-ftime-trace when compiling: the trace next to each object (foo.cpp.o -> foo.cpp.json) is read
+and every ct_string class and operator+ instantiation is counted, including the ones that were
+only used at compile time.
+
+    python3 tools/bloat_report.py build/CMakeFiles/app.dir/*.o
+    python3 tools/bloat_report.py --json report.json $(find build -name '*.o')
+
+Requires binutils-compatible `objdump` (for per-symbol sections) and `size`. Compile with
+-ffunction-sections -fdata-sections so that symbols land in sections named after them.
+"""
+import argparse
+import collections
+import json
+import os
+import re
+import subprocess
+import sys
+
+# objdump -tC: address, 7 flag characters, section, size, demangled name
+SYMBOL_LINE = re.compile(r"^[0-9a-fA-F]+ (.{7}) (\S+)\s+([0-9a-fA-F]+)\s+(.*)$")
+CT_STRING_TYPE = re.compile(r"ct_string<(\d+)(?:ul|u|ull)?, ([\w ]+?)>")
+OPERATOR_PLUS = re.compile(r"operator\+<(\d+)(?:ul|u|ull)?, (\d+)(?:ul|u|ull)?, ([\w ]+?)>")
+# GCC spells the value of a ct_string template argument as {std::array<...>{char [N]{(char)72, ...}}}
+NTTP_VALUE = re.compile(r"\{std::array<[^{}]*>\{[^{}]*\{((?:\((?:char|wchar_t|char8_t|char16_t|char32_t)\)-?\d+(?:, )?)*)\}\}\}")
+NTTP_CHAR = re.compile(r"\([\w]+\)(-?\d+)")
+
+
+def compact(name):
+    """Rewrites spelled-out template argument values as string literals."""
+    def literal(match):
+        codes = [int(c) for c in NTTP_CHAR.findall(match.group(1))]
+        text = "".join(chr(c) if 32 <= c < 127 and chr(c) not in '"\\' else "\\x%02x" % (c & 0xFF) for c in codes)
+        return '{"%s"}' % text
+    name = NTTP_VALUE.sub(literal, name)
+    return re.sub(r"(ct_string<\d+)(?:ul|u|ull)", r"\1", name)
+
+
+def section_kind(section):
+    if section.startswith(".text"):
+        return "text"
+    if section.startswith(".rodata") or section.startswith(".data.rel.ro"):
+        return "rodata"
+    if section.startswith(".data") or section.startswith(".bss") or section.startswith(".tbss"):
+        return "data"
+    return None
+
+
+def read_symbols(objdump, path):
+    output = subprocess.run([objdump, "-tC", path], capture_output=True, text=True, check=True).stdout
+    symbols = []
+    for line in output.splitlines():
+        match = SYMBOL_LINE.match(line)
+        if not match:
+            continue
+        flags, section, size, name = match.groups()
+        size = int(size, 16)
+        kind = section_kind(section)
+        # Skip section symbols ('d'), file symbols ('f') and undefined or empty entries
+        if size == 0 or kind is None or "d" in flags[5:7] or "f" in flags[5:7]:
+            continue
+        symbols.append({"name": name, "kind": kind, "size": size})
+    return symbols
+
+
+def read_section_totals(size_tool, path):
+    output = subprocess.run([size_tool, "-A", path], capture_output=True, text=True, check=True).stdout
+    totals = collections.Counter()
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[1].isdigit():
+            kind = section_kind(fields[0])
+            if kind:
+                totals[kind] += int(fields[1])
+    return totals
+
+
+def read_time_trace(path):
+    """Counts ct_string-related instantiations in a Clang -ftime-trace file."""
+    with open(path) as f:
+        events = json.load(f).get("traceEvents", [])
+    counts = collections.Counter()
+    microseconds = collections.Counter()
+    types, operators = set(), set()
+    for event in events:
+        name = event.get("name")
+        if name not in ("InstantiateClass", "InstantiateFunction"):
+            continue
+        detail = event.get("args", {}).get("detail", "")
+        plus = OPERATOR_PLUS.search(detail)
+        if plus:
+            operators.add(plus.groups())
+            counts["operator+"] += 1
+            microseconds["operator+"] += event.get("dur", 0)
+        elif name == "InstantiateClass" and detail.startswith("ct_string<"):
+            types.add(detail)
+            counts["ct_string"] += 1
+            microseconds["ct_string"] += event.get("dur", 0)
+        elif "ct_string<" in detail:
+            counts["other"] += 1
+            microseconds["other"] += event.get("dur", 0)
+    return counts, microseconds, types, operators
+
+
+def analyze(objects, objdump, size_tool):
+    totals = collections.Counter()
+    types = collections.defaultdict(lambda: {"symbols": 0, "text": 0, "rodata": 0, "data": 0})
+    operators = collections.defaultdict(lambda: {"symbols": 0, "text": 0, "rodata": 0, "data": 0})
+    parameter_objects = {"symbols": 0, "text": 0, "rodata": 0, "data": 0}
+    attributed = collections.Counter()
+    largest = []
+    trace_counts, trace_us = collections.Counter(), collections.Counter()
+    trace_types, trace_operators = set(), set()
+    traces = 0
+
+    for path in objects:
+        totals.update(read_section_totals(size_tool, path))
+        for symbol in read_symbols(objdump, path):
+            name = symbol["name"]
+            plus = OPERATOR_PLUS.search(name)
+            ct = CT_STRING_TYPE.search(name)
+            if not plus and not ct and not name.startswith("ct_detail::"):
+                continue
+            if name.startswith("template parameter object for"):
+                bucket = parameter_objects
+            elif plus:
+                bucket = operators["operator+<%s, %s, %s>" % plus.groups()]
+            elif ct:
+                bucket = types["ct_string<%s, %s>" % ct.groups()]
+            else:
+                bucket = types["(ct_detail, no ct_string type)"]
+            bucket["symbols"] += 1
+            bucket[symbol["kind"]] += symbol["size"]
+            attributed[symbol["kind"]] += symbol["size"]
+            largest.append((symbol["size"], symbol["kind"], compact(name)))
+
+        trace_path = os.path.splitext(path)[0] + ".json"
+        if os.path.exists(trace_path):
+            traces += 1
+            counts, us, trace_type_set, trace_operator_set = read_time_trace(trace_path)
+            trace_counts.update(counts)
+            trace_us.update(us)
+            trace_types |= trace_type_set
+            trace_operators |= trace_operator_set
+
+    largest.sort(key=lambda entry: (-entry[0], entry[2]))
+    report = {
+        "objects": len(objects),
+        "section_totals": dict(totals),
+        "attributed": dict(attributed),
+        "ct_string_types": dict(sorted(types.items())),
+        "operator_plus": dict(sorted(operators.items())),
+        "parameter_objects": parameter_objects,
+        "largest_symbols": [{"size": s, "kind": k, "name": n} for s, k, n in largest[:25]],
+    }
+    if traces:
+        report["time_trace"] = {
+            "files": traces,
+            "distinct_ct_string_types": len(trace_types),
+            "distinct_operator_plus": len(trace_operators),
+            "instantiations": dict(trace_counts),
+            "instantiation_ms": {k: round(v / 1000.0, 3) for k, v in trace_us.items()},
+        }
+    return report
+
+
+def print_report(report):
+    totals, attributed = report["section_totals"], report["attributed"]
+    print("objects: %d" % report["objects"])
+    for kind in ("text", "rodata"):
+        share = 100.0 * attributed.get(kind, 0) / totals[kind] if totals.get(kind) else 0.0
+        print(".%-7s %9d bytes total, %9d attributed to ct_string (%.1f%%)"
+              % (kind, totals.get(kind, 0), attributed.get(kind, 0), share))
+
+    def table(title, rows):
+        print("\n%s: %d" % (title, len(rows)))
+        if rows:
+            print("  %-44s %8s %10s %10s" % ("", "symbols", ".text", ".rodata"))
+        for name, entry in sorted(rows.items(), key=lambda item: (-(item[1]["text"] + item[1]["rodata"]), item[0])):
+            print("  %-44s %8d %10d %10d" % (name, entry["symbols"], entry["text"], entry["rodata"]))
+
+    table("emitted ct_string<N> types", report["ct_string_types"])
+    table("emitted operator+ specializations", report["operator_plus"])
+    params = report["parameter_objects"]
+    print("\ntemplate parameter objects: %d (%d bytes .rodata)" % (params["symbols"], params["rodata"]))
+
+    if "time_trace" in report:
+        trace = report["time_trace"]
+        print("\ninstantiated during compilation (-ftime-trace, %d files):" % trace["files"])
+        print("  distinct ct_string<N> types:         %d" % trace["distinct_ct_string_types"])
+        print("  distinct operator+ specializations:  %d" % trace["distinct_operator_plus"])
+        for kind, count in sorted(trace["instantiations"].items()):
+            print("  %-36s %d (%.1f ms)" % (kind + " instantiations:", count, trace["instantiation_ms"].get(kind, 0)))
+    else:
+        print("\n(no -ftime-trace output found; counts cover emitted symbols only)")
+
+    print("\nlargest symbols:")
+    for entry in report["largest_symbols"]:
+        name = entry["name"] if len(entry["name"]) <= 110 else entry["name"][:107] + "..."
+        print("  %7d %-6s %s" % (entry["size"], entry["kind"], name))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("objects", nargs="+", help="object files to analyze")
+    parser.add_argument("--objdump", default="objdump", help="objdump executable (default: %(default)s)")
+    parser.add_argument("--size", default="size", help="size executable (default: %(default)s)")
+    parser.add_argument("--json", help="also write the report as JSON to this file")
+    args = parser.parse_args()
+
+    try:
+        report = analyze(args.objects, args.objdump, args.size)
+    except (OSError, subprocess.CalledProcessError) as error:
+        sys.exit("bloat_report: %s" % error)
+    print_report(report)
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(report, f, indent=2, sort_keys=True)
+            f.write("\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
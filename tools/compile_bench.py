@@ -0,0 +1,334 @@
+#!/usr/bin/env python3
+"""Measures the compile-time cost of ct_string operations.
+
+Generates translation units that stress one operation each at sizes from 10 to 100k
+characters, compiles them against ct_string with every requested compiler and records wall
+time, peak compiler memory and object size:
+
+    concat_chain   operator+ chain of 64-character pieces adding up to the size
+    literal        one ct_string constant of that length, split into adjacent literals
+    compare        32 compile-time ==/<=> checks and 32 runtime comparisons per string pair
+
+Every case is compiled in each --mode: `import` (the modules, built once up front and reported
+as module_seconds) and `include` (the header-only library). The `baseline` TU only imports or
+includes the library; subtract it to get the cost of the operation itself. `core`, `ascii`, ...
+pull in one feature module or header each, which shows what a TU saves by using only what it
+needs. Comparing the modes gives the build throughput of each: a project of n TUs costs about
+module_seconds + n * baseline with modules and n * baseline with headers, plus the operations.
+The JSON report is deterministic apart from the measurements, so reports of two commits can be
+diffed or compared with --compare:
+
+    python3 tools/compile_bench.py --compiler g++ --compiler clang++ --output compile_bench.json
+    python3 tools/compile_bench.py --compiler g++ --compare old.json
+
+Peak memory comes from wait4() and is only available on POSIX systems. Failed compilations
+(e.g. constexpr step limits at large sizes) are recorded with their first error line. A module
+interface the compiler cannot build is listed under module_errors, and only the cases that
+import it are skipped; the run still succeeds as long as the umbrella module builds.
+"""
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+INCLUDE_DIR = os.path.join(REPO, "include")
+MODULE_DIR = os.path.join(INCLUDE_DIR, "ct_string")
+# Module interfaces in build order: each one's imports come before it. Each has a header of the
+# same name.
+MODULES = ["ct_string.core", "ct_string.ascii", "ct_string.unicode", "ct_string.format", "ct_string.hash",
+           "ct_string.source", "ct_string", "ct_string.log", "ct_string.metrics", "ct_string.io",
+           "ct_string.http", "ct_string.uring"]
+FEATURES = {module.split(".")[1]: module for module in MODULES if "." in module}
+MODES = ["import", "include"]
+DEFAULT_SIZES = [10, 100, 1000, 10000, 100000]
+PIECE = 64      # characters per operator+ operand
+LITERAL_CHUNK = 4000  # below MSVC's 16380-byte limit for a single literal
+COMPARISONS = 32
+
+
+def text_of(length, seed=0):
+    return "".join(chr(ord("a") + (i + seed) % 26) for i in range(length))
+
+
+def literal(text):
+    """A string literal split into adjacent chunks."""
+    chunks = [text[i:i + LITERAL_CHUNK] for i in range(0, len(text), LITERAL_CHUNK)] or [""]
+    return "\n    ".join('"%s"' % chunk for chunk in chunks)
+
+
+def use(mode, module="ct_string"):
+    """The line that makes a module's declarations available in the given mode."""
+    return "import %s;" % module if mode == "import" else "#include <ct_string/%s.hpp>" % module
+
+
+def tu_feature(module, mode):
+    return "%s\nint main() { return 0; }\n" % use(mode, module)
+
+
+def tu_baseline(_size, mode):
+    return tu_feature("ct_string", mode)
+
+
+def tu_concat_chain(size, mode):
+    text = text_of(size)
+    pieces = [text[i:i + PIECE] for i in range(0, size, PIECE)]
+    chain = "\n    + ".join('ct_string("%s")' % piece for piece in pieces)
+    return ("#include <cstddef>\n%s\n"
+            "constexpr auto value = %s;\n"
+            "static_assert(value.size() == %d);\n"
+            "const char* use() { return value.c_str(); }\n"
+            "int main() { return use()[0] == 'a' ? 0 : 1; }\n" % (use(mode), chain, size))
+
+
+def tu_literal(size, mode):
+    return ("#include <cstddef>\n%s\n"
+            "constexpr ct_string value = %s;\n"
+            "static_assert(value.size() == %d);\n"
+            "const char* use() { return value.c_str(); }\n"
+            "int main() { return use()[0] == 'a' ? 0 : 1; }\n" % (use(mode), literal(text_of(size)), size))
+
+
+def tu_compare(size, mode):
+    lines = ["#include <compare>", "#include <string_view>", use(mode),
+             "constexpr ct_string a = %s;" % literal(text_of(size)),
+             "constexpr ct_string b = %s;" % literal(text_of(size)),
+             "constexpr ct_string c = %s;" % literal(text_of(size, seed=1))]
+    for i in range(COMPARISONS // 2):
+        lines.append("static_assert(a == b && !(a == c)); // %d" % i)
+        lines.append("static_assert((a <=> c) < 0); // %d" % i)
+    for i in range(COMPARISONS):
+        rhs = "a" if i % 2 == 0 else "c"
+        lines.append("bool equal_%d(std::string_view v) { return %s == v; }" % (i, rhs))
+    lines.append("int main() { return equal_0(\"x\") ? 1 : 0; }")
+    return "\n".join(lines) + "\n"
+
+
+GENERATORS = {
+    "concat_chain": tu_concat_chain,
+    "literal": tu_literal,
+    "compare": tu_compare,
+}
+
+
+class Compiler:
+    """Command lines for building the modules and compiling a TU that imports or includes them."""
+
+    def __init__(self, path, kind, flags):
+        self.path = path
+        self.kind = kind
+        self.flags = flags
+
+    @staticmethod
+    def detect(path, flags):
+        name = os.path.basename(path).lower()
+        if name in ("cl", "cl.exe"):
+            return Compiler(path, "msvc", flags)
+        try:
+            version = subprocess.run([path, "--version"], capture_output=True, text=True).stdout
+        except OSError as error:
+            sys.exit("compile_bench: cannot run %s: %s" % (path, error))
+        return Compiler(path, "clang" if "clang" in version.lower() else "gcc", flags)
+
+    def version(self):
+        if self.kind == "msvc":
+            result = subprocess.run([self.path], capture_output=True, text=True)
+            return (result.stderr.strip().splitlines() or ["msvc"])[0]
+        result = subprocess.run([self.path, "--version"], capture_output=True, text=True)
+        return (result.stdout.strip().splitlines() or [self.kind])[0]
+
+    def object_suffix(self):
+        return ".obj" if self.kind == "msvc" else ".o"
+
+    def module_command(self, module):
+        source = os.path.join(MODULE_DIR, module + ".ixx")
+        if self.kind == "gcc":
+            return [self.path, "-std=c++20", "-fmodules-ts", *self.flags, "-x", "c++", "-c", source,
+                    "-o", module + ".o"]
+        if self.kind == "clang":
+            return [self.path, "-std=c++20", *self.flags, "-fprebuilt-module-path=.", "--precompile",
+                    "-x", "c++-module", source, "-o", module + ".pcm"]
+        return [self.path, "/nologo", "/std:c++20", "/EHsc", *self.flags, "/ifcSearchDir", ".", "/c", "/interface",
+                "/TP", source, "/ifcOutput", module + ".ifc", "/Fo:" + module + ".obj"]
+
+    def tu_command(self, source, obj, mode):
+        if self.kind == "msvc":
+            lookup = ["/ifcSearchDir", "."] if mode == "import" else ["/I", INCLUDE_DIR]
+            return [self.path, "/nologo", "/std:c++20", "/EHsc", *self.flags, *lookup, "/c", source, "/Fo:" + obj]
+        if mode == "include":
+            return [self.path, "-std=c++20", *self.flags, "-I", INCLUDE_DIR, "-c", source, "-o", obj]
+        if self.kind == "gcc":
+            return [self.path, "-std=c++20", "-fmodules-ts", *self.flags, "-c", source, "-o", obj]
+        return [self.path, "-std=c++20", *self.flags, "-fprebuilt-module-path=.", "-c", source, "-o", obj]
+
+
+def run_measured(command, cwd):
+    """Runs a command and returns (seconds, peak RSS in KiB or None, returncode, output)."""
+    start = time.perf_counter()
+    process = subprocess.Popen(command, cwd=cwd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    if hasattr(os, "wait4"):
+        # ru_maxrss covers the largest waited-for descendant, i.e. cc1plus/clang -cc1 behind the driver
+        output = process.stdout.read()
+        _, status, usage = os.wait4(process.pid, 0)
+        process.returncode = os.waitstatus_to_exitcode(status)
+        peak = usage.ru_maxrss // 1024 if sys.platform == "darwin" else usage.ru_maxrss
+    else:
+        output, _ = process.communicate()
+        peak = None
+    return time.perf_counter() - start, peak, process.returncode, output
+
+
+def first_error(output):
+    for line in output.splitlines():
+        if "error" in line.lower():
+            return line.strip()[:300]
+    return (output.strip().splitlines() or ["unknown failure"])[0][:300]
+
+
+def bench_compiler(compiler, mode, sizes, operations, repeat, work_dir):
+    cwd = os.path.join(work_dir, compiler.kind, mode)
+    os.makedirs(cwd, exist_ok=True)
+    run = {"compiler": compiler.version(), "kind": compiler.kind, "mode": mode}
+    failed = {}
+    if mode == "import":
+        seconds = 0.0
+        for module in MODULES:
+            elapsed, _, code, output = run_measured(compiler.module_command(module), cwd)
+            if code != 0:
+                # Modules that import this one fail in turn and are listed as well
+                failed[module] = first_error(output)
+                print("  %-22s FAILED: %s" % (module, failed[module]), file=sys.stderr)
+                continue
+            seconds += elapsed
+        run["module_seconds"] = round(seconds, 4)
+        if failed:
+            run["module_errors"] = failed
+
+    cases = [("baseline", 0)] + [(feature, 0) for feature in FEATURES] + \
+            [(op, size) for op in operations for size in sizes]
+    results = []
+    for operation, size in cases:
+        name = "%s_%d" % (operation, size)
+        source = name + ".cpp"
+        obj = name + compiler.object_suffix()
+        if operation in FEATURES:
+            text = tu_feature(FEATURES[operation], mode)
+        else:
+            text = (tu_baseline if operation == "baseline" else GENERATORS[operation])(size, mode)
+        with open(os.path.join(cwd, source), "w") as f:
+            f.write(text)
+
+        entry = {"operation": operation, "size": size}
+        needed = FEATURES[operation] if operation in FEATURES else "ct_string"
+        if needed in failed:
+            entry["skipped"] = "module %s was not built" % needed
+            results.append(entry)
+            print("  %-22s %s" % (name, describe(entry)), file=sys.stderr)
+            continue
+        times, peaks = [], []
+        for _ in range(repeat):
+            elapsed, peak_kib, code, output = run_measured(compiler.tu_command(source, obj, mode), cwd)
+            if code != 0:
+                entry["error"] = first_error(output)
+                break
+            times.append(elapsed)
+            if peak_kib is not None:
+                peaks.append(peak_kib)
+        if "error" not in entry:
+            entry["wall_seconds"] = round(min(times), 4)
+            entry["peak_memory_kib"] = max(peaks) if peaks else None
+            entry["object_bytes"] = os.path.getsize(os.path.join(cwd, obj))
+        results.append(entry)
+        print("  %-22s %s" % (name, describe(entry)), file=sys.stderr)
+    run["results"] = results
+    return run
+
+
+def describe(entry):
+    if "skipped" in entry:
+        return "skipped: " + entry["skipped"]
+    if "error" in entry:
+        return "FAILED: " + entry["error"]
+    memory = "%8d KiB" % entry["peak_memory_kib"] if entry["peak_memory_kib"] is not None else "%12s" % "-"
+    return "%8.3f s %s %10d B" % (entry["wall_seconds"], memory, entry["object_bytes"])
+
+
+def compare(old, new):
+    """Prints relative changes of wall time, memory and object size per compiler, mode and case."""
+    old_by_key = {(run["kind"], run.get("mode", "import"), r["operation"], r["size"]): r
+                  for run in old["runs"] for r in run["results"]}
+    print("%-8s %-8s %-22s %12s %12s %12s" % ("compiler", "mode", "case", "time", "memory", "object"))
+    for run in new["runs"]:
+        for r in run["results"]:
+            before = old_by_key.get((run["kind"], run["mode"], r["operation"], r["size"]))
+            if before is None or "wall_seconds" not in r or "wall_seconds" not in before:
+                continue
+            cells = []
+            for field in ("wall_seconds", "peak_memory_kib", "object_bytes"):
+                if before.get(field) and r.get(field) is not None:
+                    cells.append("%+11.1f%%" % (100.0 * (r[field] - before[field]) / before[field]))
+                else:
+                    cells.append("%12s" % "-")
+            print("%-8s %-8s %-22s %s" % (run["kind"], run["mode"], "%s_%d" % (r["operation"], r["size"]),
+                                          " ".join(cells)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--compiler", action="append", default=[],
+                        help="compiler executable (g++, clang++, cl); may be repeated")
+    parser.add_argument("--flag", action="append", default=[], help="extra compiler flag; may be repeated")
+    parser.add_argument("--sizes", default=",".join(map(str, DEFAULT_SIZES)),
+                        help="comma-separated string lengths (default: %(default)s)")
+    parser.add_argument("--operations", default=",".join(GENERATORS),
+                        help="comma-separated subset of: %s" % ", ".join(GENERATORS))
+    parser.add_argument("--mode", default=",".join(MODES),
+                        help="comma-separated subset of: %s (default: %%(default)s)" % ", ".join(MODES))
+    parser.add_argument("--repeat", type=int, default=3, help="compilations per case; the fastest is kept")
+    parser.add_argument("--output", help="write the JSON report to this file (default: stdout)")
+    parser.add_argument("--compare", help="print changes relative to an earlier JSON report")
+    parser.add_argument("--work-dir", help="keep generated sources and objects here")
+    args = parser.parse_args()
+
+    compilers = [Compiler.detect(path, args.flag) for path in (args.compiler or [os.environ.get("CXX", "c++")])]
+    sizes = [int(s) for s in args.sizes.split(",") if s]
+    operations = [op for op in args.operations.split(",") if op]
+    unknown = [op for op in operations if op not in GENERATORS]
+    if unknown:
+        sys.exit("compile_bench: unknown operation(s): %s" % ", ".join(unknown))
+    modes = [mode for mode in args.mode.split(",") if mode]
+    if not modes or any(mode not in MODES for mode in modes):
+        sys.exit("compile_bench: --mode takes a comma-separated subset of: %s" % ", ".join(MODES))
+
+    work_dir = args.work_dir or tempfile.mkdtemp(prefix="ct_string_compile_bench_")
+    try:
+        runs = []
+        for compiler in compilers:
+            for mode in modes:
+                print("%s (%s, %s)" % (compiler.path, compiler.kind, mode), file=sys.stderr)
+                runs.append(bench_compiler(compiler, mode, sizes, operations, max(1, args.repeat), work_dir))
+    finally:
+        if not args.work_dir:
+            shutil.rmtree(work_dir, ignore_errors=True)
+
+    report = {"sizes": sizes, "operations": operations, "modes": modes, "runs": runs}
+    text = json.dumps(report, indent=2, sort_keys=True) + "\n"
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+    if args.compare:
+        with open(args.compare) as f:
+            compare(json.load(f), report)
+    # Without the umbrella module nothing but the feature cases could be measured
+    return 0 if all("ct_string" not in run.get("module_errors", {}) for run in runs) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,25 @@
+# Writes a header declaring the bytes of a file as a null-terminated array, for compilers
+# without #embed. Run by ct_string_embed() at build time, or by hand:
+#
+#     cmake -DINPUT=shader.glsl -DOUTPUT=shader_glsl.hpp -DNAME=shader_glsl -P tools/embed_file.cmake
+#
+# The header defines `inline constexpr unsigned char NAME[]`; from_embedded(NAME) turns it
+# into a ct_string.
+foreach (var INPUT OUTPUT NAME)
+    if (NOT DEFINED ${var})
+        message(FATAL_ERROR "embed_file.cmake: -D${var}= is required")
+    endif()
+endforeach()
+
+file(READ "${INPUT}" hex HEX)
+# 16 bytes per line, each as 0xNN followed by a comma; the array ends with the terminating 0
+string(REGEX REPLACE "(................................)" "\\1\n" hex "${hex}")
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+
+file(WRITE "${OUTPUT}" "// Generated by ct_string tools/embed_file.cmake from ${INPUT}; do not edit.
+#pragma once
+
+inline constexpr unsigned char ${NAME}[] = {
+${bytes}
+0};
+")
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""Generates the Unicode data tables of the ct_string module from Python's unicodedata module.
+
+    unicode_tables.inc                display width (zero-width and wide ranges)
+    unicode_normalization_tables.inc  combining classes, decompositions and compositions
+
+The tables are textually included inside namespace ct_detail of the ct_string module.
+Re-run after upgrading Python to pick up a newer Unicode version:
+
+    python3 tools/gen_unicode_tables.py include/ct_string
+"""
+import contextlib
+import os
+import sys
+import unicodedata
+
+MAX_CP = 0x10FFFF
+
+
+def ranges(predicate):
+    out = []
+    start = None
+    for cp in range(MAX_CP + 2):
+        hit = cp <= MAX_CP and predicate(cp)
+        if hit and start is None:
+            start = cp
+        elif not hit and start is not None:
+            out.append((start, cp - 1))
+            start = None
+    return out
+
+
+def is_zero_width(cp):
+    # Combining marks and format characters occupy no terminal column (soft hyphen excepted),
+    # as do the Hangul medial vowels and final consonants that join onto a leading syllable.
+    if cp == 0x00AD:
+        return False
+    if 0x1160 <= cp <= 0x11FF:
+        return True
+    return unicodedata.category(chr(cp)) in ("Mn", "Me", "Cf")
+
+
+def is_wide(cp):
+    return unicodedata.east_asian_width(chr(cp)) in ("W", "F")
+
+
+def emit_ranges(name, rs):
+    print(f"// {len(rs)} ranges")
+    print(f"inline constexpr code_point_range {name}[] = {{")
+    line = "   "
+    for first, last in rs:
+        item = f" {{0x{first:04X}, 0x{last:04X}}},"
+        if len(line) + len(item) > 100:
+            print(line)
+            line = "   "
+        line += item
+    print(line)
+    print("};")
+    print()
+
+
+HANGUL_FIRST, HANGUL_LAST = 0xAC00, 0xD7A3
+
+
+def emit_u32_literal(name, comment, values):
+    # Packed as a char32_t string literal with hex escapes: compilers parse one long literal far
+    # faster than an equally long braced initializer list. The array has a trailing '\0'.
+    print(f"// {comment}")
+    print(f"// {len(values)} values")
+    print(f"inline constexpr char32_t {name}[] =")
+    line = '    U"'
+    for v in values:
+        item = f"\\x{v:X}"
+        if len(line) + len(item) > 99:
+            print(line + '"')
+            line = '    U"'
+        line += item
+    print(line + '";')
+    print()
+
+
+def normalization_tables():
+    ccc = []
+    for first, last in ranges(lambda cp: unicodedata.combining(chr(cp)) != 0):
+        # Split ranges further wherever the class changes
+        start = first
+        for cp in range(first, last + 1):
+            if unicodedata.combining(chr(cp)) != unicodedata.combining(chr(start)):
+                ccc.append((start, cp - 1, unicodedata.combining(chr(start))))
+                start = cp
+        ccc.append((start, last, unicodedata.combining(chr(start))))
+
+    code_points, nfd, nfkd, pool = [], [], [], []
+
+    def add_to_pool(seq):
+        offset = len(pool)
+        pool.extend(ord(c) for c in seq)
+        assert offset < (1 << 16) and len(seq) < (1 << 5)
+        return (offset << 5) | len(seq)
+
+    for cp in range(MAX_CP + 1):
+        if HANGUL_FIRST <= cp <= HANGUL_LAST or 0xD800 <= cp <= 0xDFFF:
+            continue  # Hangul syllables are decomposed algorithmically
+        c = chr(cp)
+        canonical = unicodedata.normalize("NFD", c)
+        compat = unicodedata.normalize("NFKD", c)
+        if canonical == c and compat == c:
+            continue
+        code_points.append(cp)
+        nfd.append(add_to_pool(canonical) if canonical != c else 0)
+        if compat == c:
+            nfkd.append(0)
+        elif compat == canonical:
+            nfkd.append(nfd[-1])
+        else:
+            nfkd.append(add_to_pool(compat))
+
+    compositions = []
+    for cp in range(MAX_CP + 1):
+        if HANGUL_FIRST <= cp <= HANGUL_LAST or 0xD800 <= cp <= 0xDFFF:
+            continue
+        c = chr(cp)
+        decomposition = unicodedata.decomposition(c)
+        if not decomposition or decomposition.startswith("<"):
+            continue
+        parts = [int(x, 16) for x in decomposition.split()]
+        # Primary composites only: composition exclusions and non-starter decompositions
+        # do not survive NFC
+        if len(parts) == 2 and unicodedata.normalize("NFC", c) == c:
+            compositions.append((parts[0], parts[1], cp))
+    compositions.sort()
+
+    emit_u32_literal("ccc_table", "Canonical combining classes: (first, last, class) triples of sorted ranges, "
+                     "class 0 omitted", [v for t in ccc for v in t])
+    emit_u32_literal("decomposition_code_points",
+                     "Code points whose NFD or NFKD differs from themselves, sorted (Hangul excluded)", code_points)
+    emit_u32_literal("decomposition_nfd",
+                     "Full canonical decomposition of decomposition_code_points[i] as "
+                     "(pool offset << 5) | length, 0 if none", nfd)
+    emit_u32_literal("decomposition_nfkd",
+                     "Full compatibility decomposition of decomposition_code_points[i] as "
+                     "(pool offset << 5) | length, 0 if none", nfkd)
+    emit_u32_literal("decomposition_pool", "Decomposed sequences, already in canonical order", pool)
+    emit_u32_literal("composition_table",
+                     "Primary composites: (first, second, composite) triples sorted by (first, second)",
+                     [v for t in compositions for v in t])
+
+
+@contextlib.contextmanager
+def output(directory, name):
+    with open(os.path.join(directory, name), "w", encoding="ascii", newline="\n") as f:
+        with contextlib.redirect_stdout(f):
+            print("// Generated by tools/gen_unicode_tables.py from Unicode "
+                  f"{unicodedata.unidata_version}. Do not edit by hand.")
+            print()
+            yield
+
+
+def main():
+    directory = sys.argv[1] if len(sys.argv) > 1 else os.path.join("include", "ct_string")
+    with output(directory, "unicode_tables.inc"):
+        emit_ranges("zero_width_ranges", ranges(is_zero_width))
+        emit_ranges("wide_ranges", ranges(is_wide))
+    with output(directory, "unicode_normalization_tables.inc"):
+        normalization_tables()
+
+
+if __name__ == "__main__":
+    sys.exit(main())